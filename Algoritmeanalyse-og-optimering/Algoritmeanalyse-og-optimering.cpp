@@ -117,10 +117,16 @@ void AddResult(BenchmarkProgress& progress, const std::string& result) {
     }
 }
 
-void RunSortingBenchmarks(int num_runs, int initial_size, int size_increment) {
+// Number of distinct keys in the "Few Unique" sorting case
+const int FEW_UNIQUE_KEYS = 16;
+
+// The "Sorted Tail" case appends size / SORTED_TAIL_FRACTION unsorted elements to sorted data
+const int SORTED_TAIL_FRACTION = 16;
+
+void RunSortingBenchmarks(int num_runs, int initial_size, int size_increment, unsigned int num_threads) {
     gProgress.isRunning = true;
     gProgress.recentResults.clear();
-    int totalOperations = num_runs * 6; // 2 algorithms * 3 cases
+    int totalOperations = num_runs * 96; // 16 series * 6 cases
     int currentOperation = 0;
 
     Instrumentor::Get().BeginSession("Sorting Benchmarks", "results_sorting.json");
@@ -128,50 +134,248 @@ void RunSortingBenchmarks(int num_runs, int initial_size, int size_increment) {
     // Pre-allocate vectors to avoid repeated allocations
     std::vector<int> merge_data;
     std::vector<int> quick_data;
+    std::vector<int> parallel_quick_data;
+    std::vector<int> intro_data;
+    std::vector<int> pivot_source;  // Unsorted copy of the case data for the pivot strategy series
+    std::vector<int> pivot_data;
+    std::vector<int> three_way_data;
+    std::vector<int> block_data;
+    std::vector<int> pdq_data;
+    std::vector<int> std_data;
+    std::vector<int> radix_data;
+    std::vector<int> american_flag_data;
+    std::vector<int> tim_data;
+    std::vector<int> buffered_data;
+    std::vector<int> parallel_data;
+    std::vector<int> sample_data;
+    std::vector<int> merge_buffer; // Scratch buffer reused by the buffered merge sort
     merge_data.reserve(initial_size + (num_runs - 1) * size_increment); // Reserve max size
     quick_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    parallel_quick_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    intro_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    pivot_source.reserve(initial_size + (num_runs - 1) * size_increment);
+    pivot_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    three_way_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    block_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    pdq_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    std_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    radix_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    american_flag_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    tim_data.reserve(initial_size + (num_runs - 1) * size_increment);
+
+    // Pivot strategies that get their own Quick Sort series in the trace
+    const std::pair<sorting::PivotStrategy, std::string> pivotSeries[] = {
+        { sorting::PivotStrategy::MEDIAN_OF_THREE, "Median of Three" },
+        { sorting::PivotStrategy::NINTHER, "Ninther" }
+    };
+    buffered_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    parallel_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    sample_data.reserve(initial_size + (num_runs - 1) * size_increment);
+    merge_buffer.reserve(initial_size + (num_runs - 1) * size_increment);
 
     // Initialize random number generator once
     std::random_device rd;
     std::mt19937 gen(rd());
 
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const std::string threadsLabel = ", Threads: " + std::to_string(num_threads);
+
     for (int size = initial_size; size <= initial_size + (num_runs - 1) * size_increment; size += size_increment) {
         merge_data.resize(size);
         quick_data.resize(size);
 
-        for (const std::string& caseType : { "Best", "Average", "Worst" }) {
+        for (const std::string& caseType : { "Best", "Average", "Worst", "Organ Pipe", "Few Unique", "Sorted Tail" }) {
             if (caseType == "Best") {
                 std::iota(merge_data.begin(), merge_data.end(), 0);
             }
             else if (caseType == "Worst") {
                 std::iota(merge_data.rbegin(), merge_data.rend(), 0);
             }
+            else if (caseType == "Organ Pipe") {
+                // Ascending first half followed by a descending second half
+                std::iota(merge_data.begin(), merge_data.begin() + size / 2, 0);
+                std::iota(merge_data.rbegin(), merge_data.rend() - size / 2, 0);
+            }
+            else if (caseType == "Few Unique") {
+                // Only a handful of distinct keys, every key is repeated size / FEW_UNIQUE_KEYS times
+                std::uniform_int_distribution<> distrib(0, FEW_UNIQUE_KEYS - 1);
+                std::generate(merge_data.begin(), merge_data.end(), [&]() { return distrib(gen); });
+            }
+            else if (caseType == "Sorted Tail") {
+                // Sorted data with a random tail of size / SORTED_TAIL_FRACTION appended, like a pre-sorted feed
+                std::uniform_int_distribution<> distrib(0, size * 2);
+                std::generate(merge_data.begin(), merge_data.end(), [&]() { return distrib(gen); });
+                std::sort(merge_data.begin(), merge_data.end() - size / SORTED_TAIL_FRACTION);
+            }
             else {
                 std::uniform_int_distribution<> distrib(0, size * 2);
                 std::generate(merge_data.begin(), merge_data.end(), [&]() { return distrib(gen); });
             }
             
-            // Copy data for quicksort before running merge sort
+            // Copy data for the other algorithms before running merge sort
             quick_data = merge_data;
+            parallel_quick_data = merge_data;
+            intro_data = merge_data;
+            pivot_source = merge_data;
+            three_way_data = merge_data;
+            block_data = merge_data;
+            pdq_data = merge_data;
+            std_data = merge_data;
+            radix_data = merge_data;
+            american_flag_data = merge_data;
+            tim_data = merge_data;
+            buffered_data = merge_data;
+            parallel_data = merge_data;
+            sample_data = merge_data;
 
             // Benchmark Merge Sort
             {
                 std::string name = "Merge Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
                 UpdateProgress(gProgress, "Merge Sort", caseType, size, ++currentOperation, totalOperations);
+                MemoryTracker::ResetPeak();
                 InstrumentationTimer timer(name.c_str(), caseType.c_str());
                 sorting::merge_sort(merge_data);
+                if (MemoryTracker::Enabled())
+                    timer.AddArg("peak_bytes", static_cast<double>(MemoryTracker::PeakBytes()));
                 AddResult(gProgress, "Merge Sort - " + caseType + " - Size " + std::to_string(size));
             }
 
+            // Benchmark LSD Radix Sort
+            {
+                std::string name = "Radix Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, "Radix Sort", caseType, size, ++currentOperation, totalOperations);
+                MemoryTracker::ResetPeak();
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::radix_sort(radix_data);
+                if (MemoryTracker::Enabled())
+                    timer.AddArg("peak_bytes", static_cast<double>(MemoryTracker::PeakBytes()));
+                AddResult(gProgress, "Radix Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark in-place American Flag Sort, peak memory shows the missing n-sized buffer
+            {
+                std::string name = "American Flag Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, "American Flag Sort", caseType, size, ++currentOperation, totalOperations);
+                MemoryTracker::ResetPeak();
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::american_flag_sort(american_flag_data);
+                if (MemoryTracker::Enabled())
+                    timer.AddArg("peak_bytes", static_cast<double>(MemoryTracker::PeakBytes()));
+                AddResult(gProgress, "American Flag Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark Tim Sort, sorted and reversed runs are found and merged instead of re-sorted
+            {
+                std::string name = "Tim Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, "Tim Sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::tim_sort(tim_data);
+                AddResult(gProgress, "Tim Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark Merge Sort with a reused scratch buffer
+            {
+                std::string name = "Buffered Merge Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, "Buffered Merge Sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::merge_sort(buffered_data, merge_buffer);
+                AddResult(gProgress, "Buffered Merge Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark Merge Sort on the thread pool
+            {
+                std::string name = "Parallel Merge Sort (" + caseType + ", Size: " + std::to_string(size) + threadsLabel + ")";
+                UpdateProgress(gProgress, "Parallel Merge Sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::parallel_merge_sort(parallel_data, num_threads);
+                AddResult(gProgress, "Parallel Merge Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark Sample Sort on the thread pool, one classification and one scatter pass instead of log p merges
+            {
+                std::string name = "Parallel Sample Sort (" + caseType + ", Size: " + std::to_string(size) + threadsLabel + ")";
+                UpdateProgress(gProgress, "Parallel Sample Sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::parallel_sample_sort(sample_data, num_threads);
+                AddResult(gProgress, "Parallel Sample Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
             // Benchmark Quick Sort with appropriate pivot strategy
+            const sorting::PivotStrategy pivotStrategy = caseType == "Worst" ? sorting::PivotStrategy::LAST : sorting::PivotStrategy::RANDOM;
             {
                 std::string name = "Quick Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
                 UpdateProgress(gProgress, "Quick Sort", caseType, size, ++currentOperation, totalOperations);
                 InstrumentationTimer timer(name.c_str(), caseType.c_str());
-                sorting::quick_sort(quick_data, 0, quick_data.size() - 1, 
-                                  caseType == "Worst" ? sorting::PivotStrategy::LAST : sorting::PivotStrategy::RANDOM);
+                sorting::quick_sort(quick_data, 0, quick_data.size() - 1, pivotStrategy);
                 AddResult(gProgress, "Quick Sort - " + caseType + " - Size " + std::to_string(size));
             }
+
+            // Benchmark Intro Sort with the same pivot strategy, the heap sort fallback keeps Worst at O(n log n)
+            {
+                std::string name = "Intro Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, "Intro Sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::intro_sort(intro_data, 0, intro_data.size() - 1, pivotStrategy);
+                AddResult(gProgress, "Intro Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark Quick Sort with three-way partitioning, equal keys are settled in one pass
+            {
+                std::string name = "Three-Way Quick Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, "Three-Way Quick Sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::quick_sort(three_way_data, 0, three_way_data.size() - 1, pivotStrategy, sorting::PartitionScheme::THREE_WAY);
+                AddResult(gProgress, "Three-Way Quick Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark Quick Sort with the branch-free block partition
+            {
+                std::string name = "Block Quick Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, "Block Quick Sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::quick_sort(block_data, 0, block_data.size() - 1, pivotStrategy, sorting::PartitionScheme::BLOCK);
+                AddResult(gProgress, "Block Quick Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark Pattern-Defeating Quick Sort
+            {
+                std::string name = "PDQ Sort (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, "PDQ Sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::pdq_sort(pdq_data, 0, pdq_data.size() - 1);
+                AddResult(gProgress, "PDQ Sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark the standard library sort as reference
+            {
+                std::string name = "std::sort (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, "std::sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                std::sort(std_data.begin(), std_data.end());
+                AddResult(gProgress, "std::sort - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark Quick Sort once per sampling pivot strategy, each strategy is its own series
+            for (const auto& series : pivotSeries) {
+                pivot_data = pivot_source;
+                std::string algorithm = "Quick Sort " + series.second;
+                std::string name = algorithm + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, algorithm, caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::quick_sort(pivot_data, 0, pivot_data.size() - 1, series.first);
+                AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Benchmark Quick Sort on the thread pool with the same pivot strategy
+            {
+                std::string name = "Parallel Quick Sort (" + caseType + ", Size: " + std::to_string(size) + threadsLabel + ")";
+                UpdateProgress(gProgress, "Parallel Quick Sort", caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::parallel_quick_sort(parallel_quick_data, 0, parallel_quick_data.size() - 1, pivotStrategy, num_threads);
+                AddResult(gProgress, "Parallel Quick Sort - " + caseType + " - Size " + std::to_string(size));
+            }
         }
     }
 
@@ -180,6 +384,683 @@ void RunSortingBenchmarks(int num_runs, int initial_size, int size_increment) {
     gProgress.isRunning = false;
 }
 
+// Each merge is repeated this often per trace event so short merges stay above the timer resolution
+const int MERGE_REPEATS = 20;
+
+void RunMergeBenchmarks(int num_runs, int initial_size, int size_increment) {
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    int totalOperations = num_runs * 4; // 2 kernels * 2 cases
+    int currentOperation = 0;
+
+    Instrumentor::Get().BeginSession("Merge Benchmarks", "results_merging.json");
+
+    // Pre-allocate vectors to avoid repeated allocations
+    std::vector<int> input;     // Two sorted runs back to back
+    std::vector<int> output;
+    input.reserve(initial_size + (num_runs - 1) * size_increment);
+    output.reserve(initial_size + (num_runs - 1) * size_increment);
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    // One merge reads every element once and writes it once
+    auto gbPerSecond = [](int size, std::chrono::high_resolution_clock::duration elapsed) {
+        double bytes = 2.0 * sizeof(int) * size * MERGE_REPEATS;
+        return bytes / std::chrono::duration<double>(elapsed).count() / 1e9;
+    };
+
+    const std::pair<void (*)(const int*, std::ptrdiff_t, const int*, std::ptrdiff_t, int*), std::string> mergeSeries[] = {
+        { sorting::scalar_merge, "Scalar Merge" },
+        { sorting::bitonic_merge, "Bitonic Merge" }
+    };
+
+    for (int size = initial_size; size <= initial_size + (num_runs - 1) * size_increment; size += size_increment) {
+        input.resize(size);
+        output.resize(size);
+        const int n1 = size / 2;
+        const int n2 = size - n1;
+
+        for (const std::string& caseType : { "Average", "Disjoint" }) {
+            if (caseType == "Disjoint") {
+                // Every element of the first run is smaller than the second run, the merge never alternates
+                std::iota(input.begin(), input.end(), 0);
+            }
+            else {
+                // Interleaved runs, the branch in the scalar merge is unpredictable
+                std::uniform_int_distribution<> distrib(0, size * 2);
+                std::generate(input.begin(), input.end(), [&]() { return distrib(gen); });
+                std::sort(input.begin(), input.begin() + n1);
+                std::sort(input.begin() + n1, input.end());
+            }
+
+            for (const auto& series : mergeSeries) {
+                std::string name = series.second + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, series.second, caseType, size, ++currentOperation, totalOperations);
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                auto start = std::chrono::high_resolution_clock::now();
+                for (int repeat = 0; repeat < MERGE_REPEATS; ++repeat)
+                    series.first(input.data(), n1, input.data() + n1, n2, output.data());
+                timer.AddArg("gb_per_s", gbPerSecond(size, std::chrono::high_resolution_clock::now() - start));
+                AddResult(gProgress, series.second + " - " + caseType + " - Size " + std::to_string(size));
+            }
+        }
+    }
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_merging.json");
+    gProgress.isRunning = false;
+}
+
+// Reference k-way merge with a binary heap of run heads, what std::priority_queue gives out of the box
+void HeapMerge(const std::vector<sorting::SortedRun>& runs, int* out) {
+    typedef std::pair<int, std::size_t> Head;   // Value and the run it came from
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap;
+    std::vector<std::ptrdiff_t> positions(runs.size(), 0);
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+        if (runs[i].size > 0)
+            heap.push(Head(runs[i].data[positions[i]++], i));
+    }
+    while (!heap.empty()) {
+        Head head = heap.top();
+        heap.pop();
+        *out++ = head.first;
+        if (positions[head.second] < runs[head.second].size)
+            heap.push(Head(runs[head.second].data[positions[head.second]++], head.second));
+    }
+}
+
+void RunKWayMergeBenchmarks(int total_size, int max_ways) {
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    int totalOperations = 0;
+    for (int ways = 2; ways <= max_ways; ways *= 2)
+        totalOperations += 2; // 2 merges per k
+    int currentOperation = 0;
+    const std::string caseType = "Average";
+
+    Instrumentor::Get().BeginSession("K-Way Merge Benchmarks", "results_kway_merge.json");
+
+    std::vector<int> input(total_size);     // k sorted runs back to back
+    std::vector<int> output(total_size);
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> distrib(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+
+    const std::pair<void (*)(const std::vector<sorting::SortedRun>&, int*), std::string> kwaySeries[] = {
+        { sorting::kway_merge, "Loser Tree Merge" },
+        { HeapMerge, "Heap Merge" }
+    };
+
+    for (int ways = 2; ways <= max_ways; ways *= 2) {
+        // Split the input into k equal runs and sort each of them
+        std::generate(input.begin(), input.end(), [&]() { return distrib(gen); });
+        std::vector<sorting::SortedRun> runs;
+        for (int i = 0; i < ways; ++i) {
+            std::ptrdiff_t begin = static_cast<std::ptrdiff_t>(total_size) * i / ways;
+            std::ptrdiff_t end = static_cast<std::ptrdiff_t>(total_size) * (i + 1) / ways;
+            std::sort(input.begin() + begin, input.begin() + end);
+            runs.push_back({ input.data() + begin, end - begin });
+        }
+
+        for (const auto& series : kwaySeries) {
+            std::string algorithm = series.second + " (k = " + std::to_string(ways) + ")";
+            std::string name = algorithm + " (" + caseType + ", Size: " + std::to_string(total_size) + ")";
+            UpdateProgress(gProgress, algorithm, caseType, total_size, ++currentOperation, totalOperations);
+            InstrumentationTimer timer(name.c_str(), caseType.c_str());
+            auto start = std::chrono::high_resolution_clock::now();
+            series.first(runs, output.data());
+            double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+            // One merge reads every element once and writes it once
+            timer.AddArg("ways", ways);
+            timer.AddArg("gb_per_s", 2.0 * sizeof(int) * total_size / seconds / 1e9);
+            timer.Stop();
+            AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(total_size));
+        }
+    }
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_kway_merge.json");
+    gProgress.isRunning = false;
+}
+
+// Elements the scaling benchmark sorts untimed at every thread count before the timed run
+const int SCALING_WARMUP_SIZE = 1 << 10;
+
+void RunScalingBenchmarks(int size, unsigned int max_threads) {
+    if (max_threads == 0) {
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    int totalOperations = static_cast<int>(max_threads) * 3; // 3 parallel sorts per thread count
+    int currentOperation = 0;
+    const std::string caseType = "Average";
+
+    Instrumentor::Get().BeginSession("Scaling Benchmarks", "results_scaling.json");
+
+    std::vector<int> source(size);
+    std::vector<int> data;
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> distrib(0, size * 2);
+    std::generate(source.begin(), source.end(), [&]() { return distrib(gen); });
+
+    const std::pair<std::function<void(std::vector<int>&, unsigned int)>, std::string> scalingSeries[] = {
+        { [](std::vector<int>& v, unsigned int threads) { sorting::parallel_sample_sort(v, threads); }, "Parallel Sample Sort" },
+        { [](std::vector<int>& v, unsigned int threads) { sorting::parallel_merge_sort(v, threads); }, "Parallel Merge Sort" },
+        { [](std::vector<int>& v, unsigned int threads) {
+            sorting::parallel_quick_sort(v, 0, v.size() - 1, sorting::PivotStrategy::NINTHER, threads);
+        }, "Parallel Quick Sort" }
+    };
+
+    // Same input and size for every thread count, speedup is relative to the series' own one-thread time
+    for (const auto& series : scalingSeries) {
+        double singleThreadSeconds = 0.0;
+        for (unsigned int threads = 1; threads <= max_threads; ++threads) {
+            // Sort a small slice first so the pool for this thread count is spawned outside the timed region
+            data.assign(source.begin(), source.begin() + std::min(size, SCALING_WARMUP_SIZE));
+            series.first(data, threads);
+
+            data = source;
+            std::string algorithm = series.second + " (Threads: " + std::to_string(threads) + ")";
+            std::string name = algorithm + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+            UpdateProgress(gProgress, algorithm, caseType, size, ++currentOperation, totalOperations);
+            InstrumentationTimer timer(name.c_str(), caseType.c_str());
+            auto start = std::chrono::high_resolution_clock::now();
+            series.first(data, threads);
+            double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            if (threads == 1)
+                singleThreadSeconds = seconds;
+
+            timer.AddArg("threads", threads);
+            timer.AddArg("speedup", singleThreadSeconds / seconds);
+            timer.AddArg("efficiency", singleThreadSeconds / seconds / threads);
+            timer.Stop();
+            AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(size));
+        }
+    }
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_scaling.json");
+    gProgress.isRunning = false;
+}
+
+// The streaming top-k sees the input in chunks of this many elements, like reads from a file or socket
+const int TOP_K_STREAM_CHUNK = 1 << 16;
+
+void RunSelectionBenchmarks(int size, const std::vector<int>& ks) {
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    int totalOperations = static_cast<int>(ks.size()) * 5; // 5 series per k
+    int currentOperation = 0;
+    const std::string caseType = "Average";
+
+    Instrumentor::Get().BeginSession("Selection Benchmarks", "results_selection.json");
+
+    std::vector<int> source(size);
+    std::vector<int> data;
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> distrib(0, size * 2);
+
+    const std::pair<std::function<void(std::vector<int>&, int)>, std::string> selectionSeries[] = {
+        { [](std::vector<int>& v, int k) {
+            sorting::intro_select(v, 0, v.size() - 1, k - 1, sorting::PivotStrategy::MEDIAN_OF_THREE);
+        }, "Intro Select" },
+        { [](std::vector<int>& v, int k) { std::nth_element(v.begin(), v.begin() + (k - 1), v.end()); }, "std::nth_element" },
+        { [](std::vector<int>& v, int k) { sorting::partial_sort(v, 0, v.size() - 1, k); }, "Partial Sort" },
+        { [](std::vector<int>& v, int k) {
+            sorting::StreamingTopK topK(k);
+            for (std::size_t first = 0; first < v.size(); first += TOP_K_STREAM_CHUNK)
+                topK.push(v.data() + first, std::min<std::size_t>(TOP_K_STREAM_CHUNK, v.size() - first));
+            topK.sorted();
+        }, "Streaming Top-K" },
+        { [](std::vector<int>& v, int) { sorting::pdq_sort(v, 0, v.size() - 1); }, "PDQ Sort" }
+    };
+
+    // Every k runs on fresh random data, the full sort is the baseline the selections save against
+    for (int k : ks) {
+        std::generate(source.begin(), source.end(), [&]() { return distrib(gen); });
+        for (const auto& series : selectionSeries) {
+            data = source;
+            std::string algorithm = series.second + " (k = " + std::to_string(k) + ")";
+            std::string name = algorithm + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+            UpdateProgress(gProgress, algorithm, caseType, size, ++currentOperation, totalOperations);
+            InstrumentationTimer timer(name.c_str(), caseType.c_str());
+            series.first(data, k);
+            timer.AddArg("k", k);
+            timer.Stop();
+            AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(size));
+        }
+    }
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_selection.json");
+    gProgress.isRunning = false;
+}
+
+void RunSegmentedSortBenchmarks(int total_size, const std::vector<std::pair<int, int>>& length_ranges, unsigned int num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    int totalOperations = static_cast<int>(length_ranges.size()) * 3; // 3 series per length range
+    int currentOperation = 0;
+    const std::string caseType = "Average";
+
+    Instrumentor::Get().BeginSession("Segmented Sort Benchmarks", "results_segmented.json");
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> distrib(0, total_size * 2);
+
+    for (const auto& range : length_ranges) {
+        // Step 1: Cut about total_size elements into segments with lengths uniform in [range.first, range.second]
+        std::uniform_int_distribution<> lengthDistrib(range.first, range.second);
+        std::vector<std::ptrdiff_t> offsets(1, 0);
+        while (offsets.back() < total_size)
+            offsets.push_back(offsets.back() + lengthDistrib(gen));
+        const int size = static_cast<int>(offsets.back());
+        const int segments = static_cast<int>(offsets.size()) - 1;
+
+        std::vector<int> source(size);
+        std::generate(source.begin(), source.end(), [&]() { return distrib(gen); });
+
+        const std::string lengths = "Lengths: " + std::to_string(range.first) + "-" + std::to_string(range.second);
+        const std::pair<std::function<void()>, std::string> segmentedSeries[] = {
+            // Baseline: every segment is its own vector sorted by merge_sort, as the callers do today
+            { [&]() {
+                std::vector<std::vector<int>> arrays(segments);
+                for (int i = 0; i < segments; ++i)
+                    arrays[i].assign(source.begin() + offsets[i], source.begin() + offsets[i + 1]);
+                InstrumentationTimer timer(("Merge Sort Per Array (" + lengths + ", Size: " + std::to_string(size) + ")").c_str(), caseType.c_str());
+                for (auto& array : arrays)
+                    sorting::merge_sort(array);
+                timer.AddArg("segments", segments);
+            }, "Merge Sort Per Array" },
+            { [&]() {
+                std::vector<int> data = source;
+                InstrumentationTimer timer(("Segmented Sort (Threads: 1, " + lengths + ", Size: " + std::to_string(size) + ")").c_str(), caseType.c_str());
+                sorting::segmented_sort(data, offsets, 1);
+                timer.AddArg("segments", segments);
+            }, "Segmented Sort (Threads: 1)" },
+            { [&]() {
+                std::vector<int> data = source;
+                InstrumentationTimer timer(("Segmented Sort (Threads: " + std::to_string(num_threads) + ", " + lengths + ", Size: " + std::to_string(size) + ")").c_str(), caseType.c_str());
+                sorting::segmented_sort(data, offsets, num_threads);
+                timer.AddArg("segments", segments);
+            }, "Segmented Sort (Threads: " + std::to_string(num_threads) + ")" }
+        };
+
+        // Step 2: Time every series on the same segments, the copies into place happen outside the timers
+        for (const auto& series : segmentedSeries) {
+            std::string algorithm = series.second + " (" + lengths + ")";
+            UpdateProgress(gProgress, algorithm, caseType, size, ++currentOperation, totalOperations);
+            series.first();
+            AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(size));
+        }
+    }
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_segmented.json");
+    gProgress.isRunning = false;
+}
+
+void RunInPlaceMergeBenchmarks(int initial_size, int max_size) {
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    const char* const caseTypes[] = { "Average", "Few Unique" };
+    int totalOperations = 0;
+    for (int size = initial_size; size <= max_size; size *= 2)
+        totalOperations += 6; // 3 series * 2 cases
+    int currentOperation = 0;
+
+    Instrumentor::Get().BeginSession("In-Place Merge Benchmarks", "results_in_place_merge.json");
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    const std::pair<std::function<void(std::vector<int>&)>, std::string> inPlaceSeries[] = {
+        { [](std::vector<int>& v) { sorting::merge_sort(v); }, "Merge Sort" },
+        { [](std::vector<int>& v) { std::vector<int> buffer; sorting::merge_sort(v, buffer); }, "Buffered Merge Sort" },
+        { [](std::vector<int>& v) { sorting::in_place_merge_sort(v); }, "In-Place Merge Sort" }
+    };
+
+    for (int size = initial_size; size <= max_size; size *= 2) {
+        for (const std::string& caseType : caseTypes) {
+            // Few unique keys give long runs of equal elements, the case where stability matters
+            std::uniform_int_distribution<> distrib(0, caseType == "Average" ? size * 2 : FEW_UNIQUE_KEYS - 1);
+            std::vector<int> source(size);
+            std::generate(source.begin(), source.end(), [&]() { return distrib(gen); });
+
+            for (const auto& series : inPlaceSeries) {
+                std::vector<int> data = source;
+                std::string name = series.second + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, series.second, caseType, size, ++currentOperation, totalOperations);
+                MemoryTracker::ResetPeak();
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                series.first(data);
+                if (MemoryTracker::Enabled())
+                    timer.AddArg("peak_bytes", static_cast<double>(MemoryTracker::PeakBytes()));
+                timer.Stop();
+                AddResult(gProgress, series.second + " - " + caseType + " - Size " + std::to_string(size));
+            }
+        }
+    }
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_in_place_merge.json");
+    gProgress.isRunning = false;
+}
+
+void RunCacheBlockedBenchmarks(int initial_size, int max_size) {
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    int totalOperations = 0;
+    for (int size = initial_size; size <= max_size; size *= 2)
+        totalOperations += 3; // 3 series per size
+    int currentOperation = 0;
+    const std::string caseType = "Average";
+
+    // The block size of the cache-blocked sort comes from these, print them so the results can be read against them
+    const sorting::CacheSizes& caches = sorting::detect_cache_sizes();
+    std::cout << "Detected caches: L1 " << caches.l1 / 1024 << " KiB, L2 " << caches.l2 / 1024
+              << " KiB, L3 " << caches.l3 / 1024 << " KiB" << std::endl;
+
+    Instrumentor::Get().BeginSession("Cache-Blocked Benchmarks", "results_cache_blocked.json");
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    const std::pair<std::function<void(std::vector<int>&)>, std::string> cacheSeries[] = {
+        { [](std::vector<int>& v) { sorting::merge_sort(v); }, "Merge Sort" },
+        { [](std::vector<int>& v) { std::vector<int> buffer; sorting::merge_sort(v, buffer); }, "Buffered Merge Sort" },
+        { [](std::vector<int>& v) { sorting::cache_blocked_merge_sort(v); }, "Cache-Blocked Merge Sort" }
+    };
+
+    for (int size = initial_size; size <= max_size; size *= 2) {
+        std::uniform_int_distribution<> distrib(0, size * 2);
+        std::vector<int> source(size);
+        std::generate(source.begin(), source.end(), [&]() { return distrib(gen); });
+
+        // Smallest level the data and its equally large merge buffer fit in together, 4 is DRAM
+        const std::size_t bytes = 2 * sizeof(int) * static_cast<std::size_t>(size);
+        const int level = bytes <= caches.l1 ? 1 : bytes <= caches.l2 ? 2 : bytes <= caches.l3 ? 3 : 4;
+
+        for (const auto& series : cacheSeries) {
+            std::vector<int> data = source;
+            std::string name = series.second + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+            UpdateProgress(gProgress, series.second, caseType, size, ++currentOperation, totalOperations);
+            InstrumentationTimer timer(name.c_str(), caseType.c_str());
+            series.first(data);
+            timer.AddArg("bytes", static_cast<double>(bytes));
+            timer.AddArg("cache_level", level);
+            timer.Stop();
+            AddResult(gProgress, series.second + " - " + caseType + " - Size " + std::to_string(size));
+        }
+    }
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_cache_blocked.json");
+    gProgress.isRunning = false;
+}
+
+// One row of the key-value benchmark table in array-of-structs layout
+struct KeyValueRecord {
+    int key;
+    std::uint64_t payload;
+};
+
+void RunKeyValueBenchmarks(int initial_size, int max_size) {
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    int totalOperations = 0;
+    for (int size = initial_size; size <= max_size; size *= 2)
+        totalOperations += 6; // 3 layouts * 2 backends
+    int currentOperation = 0;
+    const std::string caseType = "Average";
+
+    Instrumentor::Get().BeginSession("Key-Value Benchmarks", "results_key_value.json");
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    const std::pair<sorting::KeyValueBackend, std::string> backendSeries[] = {
+        { sorting::KeyValueBackend::RADIX, "Radix" },
+        { sorting::KeyValueBackend::MERGE, "Merge" }
+    };
+
+    for (int size = initial_size; size <= max_size; size *= 2) {
+        // The same table as two columns (SoA) and as records (AoS), the payload is the original row number
+        std::uniform_int_distribution<> distrib(0, size * 2);
+        std::vector<int> sourceKeys(size);
+        std::generate(sourceKeys.begin(), sourceKeys.end(), [&]() { return distrib(gen); });
+        std::vector<std::uint64_t> sourcePayloads(size);
+        std::iota(sourcePayloads.begin(), sourcePayloads.end(), 0);
+
+        for (const auto& backend : backendSeries) {
+
+            // Struct of arrays: sort the key column and carry the payload column along
+            {
+                std::vector<int> keys = sourceKeys;
+                std::vector<std::uint64_t> payloads = sourcePayloads;
+                std::string algorithm = "SoA Sort By Key (" + backend.second + ")";
+                std::string name = algorithm + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, algorithm, caseType, size, ++currentOperation, totalOperations);
+                MemoryTracker::ResetPeak();
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::sort_by_key(keys, payloads, backend.first);
+                if (MemoryTracker::Enabled())
+                    timer.AddArg("peak_bytes", static_cast<double>(MemoryTracker::PeakBytes()));
+                timer.Stop();
+                AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Array of structs: sort whole records by their key member
+            {
+                std::vector<KeyValueRecord> records(size);
+                for (int i = 0; i < size; ++i)
+                    records[i] = { sourceKeys[i], sourcePayloads[i] };
+                std::string algorithm = "AoS Sort By Key (" + backend.second + ")";
+                std::string name = algorithm + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, algorithm, caseType, size, ++currentOperation, totalOperations);
+                MemoryTracker::ResetPeak();
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                sorting::sort_records_by_key(records.begin(), records.end(), [](const KeyValueRecord& r) { return r.key; }, backend.first);
+                if (MemoryTracker::Enabled())
+                    timer.AddArg("peak_bytes", static_cast<double>(MemoryTracker::PeakBytes()));
+                timer.Stop();
+                AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(size));
+            }
+
+            // Index then gather: argsort the keys once, then permute every column with the index
+            {
+                std::vector<int> keys = sourceKeys;
+                std::vector<std::uint64_t> payloads = sourcePayloads;
+                std::string algorithm = "Argsort + Gather (" + backend.second + ")";
+                std::string name = algorithm + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+                UpdateProgress(gProgress, algorithm, caseType, size, ++currentOperation, totalOperations);
+                MemoryTracker::ResetPeak();
+                InstrumentationTimer timer(name.c_str(), caseType.c_str());
+                std::vector<std::uint32_t> order = sorting::argsort(keys, backend.first);
+                keys = sorting::gather(keys, order);
+                payloads = sorting::gather(payloads, order);
+                if (MemoryTracker::Enabled())
+                    timer.AddArg("peak_bytes", static_cast<double>(MemoryTracker::PeakBytes()));
+                timer.Stop();
+                AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(size));
+            }
+        }
+    }
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_key_value.json");
+    gProgress.isRunning = false;
+}
+
+// Copies of the data the large tier holds at once: the unsorted source, the array being sorted and a sort buffer
+const int LARGE_TIER_COPIES = 3;
+
+void RunLargeBenchmarks(std::size_t size, unsigned int num_threads) {
+    const std::size_t neededBytes = LARGE_TIER_COPIES * size * sizeof(int);
+    if (sizeof(std::size_t) < 8 || MemoryTracker::AvailablePhysicalBytes() < neededBytes) {
+        std::cout << "Skipping large benchmarks, " << size << " elements need "
+                  << neededBytes / (1024 * 1024 * 1024) << " GB of free RAM on a 64-bit build" << std::endl;
+        return;
+    }
+
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    int totalOperations = 7; // 5 sorts + 2 searches
+    int currentOperation = 0;
+    const std::string caseType = "Average";
+
+    Instrumentor::Get().BeginSession("Large Benchmarks", "results_large.json");
+
+    std::vector<int> source(size);
+    std::vector<int> data;
+    std::vector<int> buffer;
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> distrib(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    std::generate(source.begin(), source.end(), [&]() { return distrib(gen); });
+
+    auto runSort = [&](const std::string& algorithm, const std::function<void()>& sort) {
+        data = source;
+        std::string name = algorithm + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+        UpdateProgress(gProgress, algorithm, caseType, static_cast<int>(std::min<std::size_t>(size, INT_MAX)), ++currentOperation, totalOperations);
+        InstrumentationTimer timer(name.c_str(), caseType.c_str());
+        sort();
+        AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(size));
+    };
+
+    const std::ptrdiff_t last = static_cast<std::ptrdiff_t>(size) - 1;
+    runSort("Radix Sort", [&]() { sorting::radix_sort(data); });
+    runSort("PDQ Sort", [&]() { sorting::pdq_sort(data, 0, last); });
+    runSort("Buffered Merge Sort", [&]() { sorting::merge_sort(data, buffer); });
+    runSort("Parallel Quick Sort", [&]() { sorting::parallel_quick_sort(data, 0, last, sorting::PivotStrategy::NINTHER, num_threads); });
+    runSort("std::sort", [&]() { std::sort(data.begin(), data.end()); });
+
+    // Search the sorted data for its last element, every probe lands past index 2^31
+    const int target = data.back();
+    {
+        std::string name = "Binary Search (" + caseType + ", Size: " + std::to_string(size) + ")";
+        UpdateProgress(gProgress, "Binary Search", caseType, static_cast<int>(std::min<std::size_t>(size, INT_MAX)), ++currentOperation, totalOperations);
+        InstrumentationTimer timer(name.c_str(), caseType.c_str());
+        searching::binary_search(data.data(), data.size(), target);
+        AddResult(gProgress, "Binary Search - " + caseType + " - Size " + std::to_string(size));
+    }
+    {
+        std::string name = "Interpolation Search (" + caseType + ", Size: " + std::to_string(size) + ")";
+        UpdateProgress(gProgress, "Interpolation Search", caseType, static_cast<int>(std::min<std::size_t>(size, INT_MAX)), ++currentOperation, totalOperations);
+        InstrumentationTimer timer(name.c_str(), caseType.c_str());
+        searching::interpolation_once_binary_search(data.data(), data.size(), target);
+        AddResult(gProgress, "Interpolation Search - " + caseType + " - Size " + std::to_string(size));
+    }
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_large.json");
+    gProgress.isRunning = false;
+}
+
+// Block size used to write the external sort dataset to disk
+const std::size_t EXTERNAL_WRITE_BLOCK = std::size_t(1) << 20;
+
+void RunExternalSortBenchmarks(std::size_t memory_bytes, const std::vector<int>& dataset_multiples) {
+    gProgress.isRunning = true;
+    gProgress.recentResults.clear();
+    int totalOperations = static_cast<int>(dataset_multiples.size()) * 2; // 2 pipelines
+    int currentOperation = 0;
+    const std::string caseType = "Average";
+    const std::string inputPath = "external_input.bin";
+    const std::string outputPath = "external_output.bin";
+
+    Instrumentor::Get().BeginSession("External Sort Benchmarks", "results_external.json");
+
+    // Initialize random number generator once
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> distrib(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    std::vector<int> block(EXTERNAL_WRITE_BLOCK);
+
+    const std::pair<bool (*)(const std::string&, const std::string&, std::size_t, sorting::ExternalSortStats*), std::string> externalSeries[] = {
+        { sorting::external_sort, "External Sort" },
+        { sorting::pipelined_external_sort, "Pipelined External Sort" }
+    };
+
+    for (int multiple : dataset_multiples) {
+        // Write a dataset several times larger than the memory budget, one block at a time
+        const std::size_t size = memory_bytes / sizeof(int) * multiple;
+        {
+            std::ofstream input(inputPath, std::ios::binary | std::ios::trunc);
+            for (std::size_t written = 0; written < size; written += block.size()) {
+                std::size_t count = std::min(block.size(), size - written);
+                std::generate(block.begin(), block.begin() + count, [&]() { return distrib(gen); });
+                input.write(reinterpret_cast<const char*>(block.data()), count * sizeof(int));
+            }
+            if (!input) {
+                std::cout << "Could not write " << inputPath << ", skipping external sort benchmarks" << std::endl;
+                break;
+            }
+        }
+
+        for (const auto& series : externalSeries) {
+            std::string algorithm = series.second + " (Budget: " + std::to_string(memory_bytes / (1024 * 1024)) + " MB)";
+            std::string name = algorithm + " (" + caseType + ", Size: " + std::to_string(size) + ")";
+            UpdateProgress(gProgress, algorithm, caseType, static_cast<int>(std::min<std::size_t>(size, INT_MAX)), ++currentOperation, totalOperations);
+            InstrumentationTimer timer(name.c_str(), caseType.c_str());
+            sorting::ExternalSortStats stats;
+            auto start = std::chrono::high_resolution_clock::now();
+            if (!series.first(inputPath, outputPath, memory_bytes, &stats))
+                std::cout << series.second << " of " << inputPath << " failed" << std::endl;
+            double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+            // Throughput is the dataset size over the whole sort, every pass reads and writes it once more
+            timer.AddArg("mb_per_s", size * sizeof(int) / seconds / (1024 * 1024));
+            timer.AddArg("runs", static_cast<double>(stats.runs));
+            timer.AddArg("merge_passes", stats.merge_passes);
+            timer.AddArg("run_seconds", stats.run_seconds);
+            timer.AddArg("merge_seconds", stats.merge_seconds);
+
+            // Fraction of the sort each stage was busy, the stage closest to 1 bounds throughput
+            const double elapsed = stats.run_seconds + stats.merge_seconds;
+            if (elapsed > 0.0) {
+                timer.AddArg("read_utilization", stats.read_busy_seconds / elapsed);
+                timer.AddArg("sort_utilization", stats.sort_busy_seconds / elapsed);
+                timer.AddArg("merge_utilization", stats.merge_busy_seconds / elapsed);
+                timer.AddArg("write_utilization", stats.write_busy_seconds / elapsed);
+            }
+            timer.Stop();
+            AddResult(gProgress, algorithm + " - " + caseType + " - Size " + std::to_string(size));
+        }
+    }
+
+    std::remove(inputPath.c_str());
+    std::remove(outputPath.c_str());
+
+    Instrumentor::Get().EndSession();
+    SaveProfilingData("results_external.json");
+    gProgress.isRunning = false;
+}
+
 void RunSearchingBenchmarks(int num_runs, int initial_size, int size_increment) {
     gProgress.isRunning = true;
     gProgress.recentResults.clear();
@@ -362,6 +1243,9 @@ void RunVisualizer(std::string filePath) {
 bool BENCHMARK = true;
 bool VISUALIZE = true;
 bool ENABLE_WARMUP = true;  // Enable warmup runs
+bool REPRODUCIBLE_PIVOTS = false;  // Seed the random pivot generator with RANDOM_PIVOT_SEED
+bool LARGE_TIER = true;     // Run the billion-element tier when the machine has the RAM for it
+bool EXTERNAL_SORT = true;  // Sort on-disk datasets larger than EXTERNAL_MEMORY_BUDGET
 
 // Configuration constants for benchmarking
 const int WARMUP_RUNS = 3;
@@ -372,6 +1256,25 @@ const int BENCHMARK_RUNS = 50;       // Increased from 20 for more data points
 const int INITIAL_SIZE = 1000;       // Reduced initial size for more granular data
 const int SIZE_INCREMENT = 2000;     // Smaller increments for more data points
 
+const std::uint64_t RANDOM_PIVOT_SEED = 20241017;
+const std::size_t LARGE_TIER_SIZE = (std::size_t(1) << 31) + (std::size_t(1) << 26);  // Past the 2^31 limit of int indices
+const std::size_t EXTERNAL_MEMORY_BUDGET = std::size_t(64) << 20;    // RAM the external sort may use
+const std::vector<int> EXTERNAL_DATASET_MULTIPLES = { 2, 4, 8, 16 };  // On-disk dataset sizes as multiples of the budget
+const int KWAY_MERGE_SIZE = 1 << 22;  // Elements merged per k in the k-way merge sweep
+const int KWAY_MAX_WAYS = 1024;       // The sweep doubles k from 2 up to this
+const int SCALING_SIZE = 1 << 24;     // Elements sorted at every thread count in the strong-scaling benchmark
+const int SELECTION_SIZE = 1 << 22;   // Elements the selection benchmark selects from
+const std::vector<int> SELECTION_KS = { 1, 10, 100, 1000, 10000, 100000, SELECTION_SIZE / 2 };  // Last k is the median
+const int CACHE_BLOCKED_INITIAL_SIZE = 1 << 10;  // 4 KiB, well inside L1
+const int CACHE_BLOCKED_MAX_SIZE = 1 << 26;      // 256 MiB, past any L3
+const int IN_PLACE_MERGE_INITIAL_SIZE = 1 << 10;  // The in-place merge benchmark doubles the size from here
+const int IN_PLACE_MERGE_MAX_SIZE = 1 << 22;      // up to here
+const int SEGMENTED_TOTAL_SIZE = 1 << 24;  // Elements split into segments per length range in the segmented sort benchmark
+const std::vector<std::pair<int, int>> SEGMENT_LENGTH_RANGES = { { 8, 8 }, { 32, 32 }, { 256, 256 }, { 8, 64 }, { 8, 256 } };  // Uniform [min, max] segment lengths
+const int KEY_VALUE_INITIAL_SIZE = 1 << 10;  // The key-value benchmark doubles the table size from here
+const int KEY_VALUE_MAX_SIZE = 1 << 22;      // up to here
+const int SMALL_SORT_CUTOFF = 32;    // Merge/quick sort ranges up to this size use the sorting network kernel (0 = off)
+
 int main() {
     // Allow switching between sorting and searching results
     std::vector<std::string> resultFiles = {"results_sorting.json", "results_searching.json"};
@@ -379,6 +1282,10 @@ int main() {
 
     if (BENCHMARK) {
         // Run both sorting and searching benchmarks
+        sorting::set_small_sort_cutoff(SMALL_SORT_CUTOFF);
+        if (REPRODUCIBLE_PIVOTS) {
+            sorting::set_random_pivot_seed(RANDOM_PIVOT_SEED);
+        }
         std::cout << "Running sorting benchmarks..." << std::endl;
         if (ENABLE_WARMUP) {
             std::cout << "Performing sorting warmup runs..." << std::endl;
@@ -387,6 +1294,35 @@ int main() {
         }
         RunSortingBenchmarks(BENCHMARK_RUNS, INITIAL_SIZE, SIZE_INCREMENT);
 
+        std::cout << "\nRunning scaling benchmarks..." << std::endl;
+        RunScalingBenchmarks(SCALING_SIZE);
+
+        std::cout << "\nRunning selection benchmarks..." << std::endl;
+        RunSelectionBenchmarks(SELECTION_SIZE, SELECTION_KS);
+
+        std::cout << "\nRunning cache-blocked benchmarks..." << std::endl;
+        RunCacheBlockedBenchmarks(CACHE_BLOCKED_INITIAL_SIZE, CACHE_BLOCKED_MAX_SIZE);
+
+        std::cout << "\nRunning in-place merge benchmarks..." << std::endl;
+        RunInPlaceMergeBenchmarks(IN_PLACE_MERGE_INITIAL_SIZE, IN_PLACE_MERGE_MAX_SIZE);
+
+        std::cout << "\nRunning segmented sort benchmarks..." << std::endl;
+        RunSegmentedSortBenchmarks(SEGMENTED_TOTAL_SIZE, SEGMENT_LENGTH_RANGES);
+
+        std::cout << "\nRunning key-value benchmarks..." << std::endl;
+        RunKeyValueBenchmarks(KEY_VALUE_INITIAL_SIZE, KEY_VALUE_MAX_SIZE);
+
+        std::cout << "\nRunning merge benchmarks..." << std::endl;
+        if (ENABLE_WARMUP) {
+            std::cout << "Performing merge warmup runs..." << std::endl;
+            RunMergeBenchmarks(WARMUP_RUNS, WARMUP_INITIAL_SIZE, WARMUP_SIZE_INCREMENT);
+            std::cout << "Warmup complete. Starting actual benchmarks..." << std::endl;
+        }
+        RunMergeBenchmarks(BENCHMARK_RUNS, INITIAL_SIZE, SIZE_INCREMENT);
+
+        std::cout << "\nRunning k-way merge benchmarks..." << std::endl;
+        RunKWayMergeBenchmarks(KWAY_MERGE_SIZE, KWAY_MAX_WAYS);
+
         std::cout << "\nRunning searching benchmarks..." << std::endl;
         if (ENABLE_WARMUP) {
             std::cout << "Performing searching warmup runs..." << std::endl;
@@ -394,6 +1330,16 @@ int main() {
             std::cout << "Warmup complete. Starting actual benchmarks..." << std::endl;
         }
         RunSearchingBenchmarks(BENCHMARK_RUNS, INITIAL_SIZE, SIZE_INCREMENT);
+
+        if (LARGE_TIER) {
+            std::cout << "\nRunning large benchmarks..." << std::endl;
+            RunLargeBenchmarks(LARGE_TIER_SIZE);
+        }
+
+        if (EXTERNAL_SORT) {
+            std::cout << "\nRunning external sort benchmarks..." << std::endl;
+            RunExternalSortBenchmarks(EXTERNAL_MEMORY_BUDGET, EXTERNAL_DATASET_MULTIPLES);
+        }
     }
 
     if (VISUALIZE) {
@@ -18,6 +18,9 @@
 #include <chrono>
 #include <algorithm>
 #include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 #include <thread>
 
@@ -27,8 +30,26 @@ struct ProfileResult
 	long long Start, End; // Start and end times of the profiled scope
 	uint32_t ThreadID; // Thread ID 
 	std::string Category; // Category of the profiled scope
+	std::vector<std::pair<std::string, double>> Args; // Extra metrics, written to the "args" object of the event
 };
 
+// Writes the "args" object of a trace event, e.g. "args":{"peak_bytes":4096},
+inline void WriteProfileArgs(std::ostream& stream, const ProfileResult& result)
+{
+    stream << "\"args\":{";
+    for (size_t i = 0; i < result.Args.size(); ++i)
+    {
+        std::ostringstream value;
+        value.precision(15);
+        value << result.Args[i].second;
+
+        if (i > 0)
+            stream << ",";
+        stream << "\"" << result.Args[i].first << "\":" << value.str();
+    }
+    stream << "},";
+}
+
 struct InstrumentationSession
 {
     std::string Name;
@@ -77,6 +98,7 @@ public:
 
         m_OutputStream << "{";
         m_OutputStream << "\"cat\":\"" << result.Category << "\",";
+        WriteProfileArgs(m_OutputStream, result);
         m_OutputStream << "\"dur\":" << (result.End - result.Start) << ',';
         m_OutputStream << "\"name\":\"" << name << "\",";
         m_OutputStream << "\"ph\":\"X\",";
@@ -134,18 +156,25 @@ public:
         long long duration = std::chrono::duration_cast<std::chrono::microseconds>(endTimepoint - m_StartTimepoint).count();
 
         uint32_t threadID = std::hash<std::thread::id>{}(std::this_thread::get_id());
-        ProfileResult result = { m_Name, start.count(), end.count(), threadID, m_Category };
+        ProfileResult result = { m_Name, start.count(), end.count(), threadID, m_Category, m_Args };
         Instrumentor::Get().WriteProfile(result);
         Instrumentor::Get().AddResult(result);
 
         m_Stopped = true;
     }
 
+    // Attaches an extra metric to this scope's trace event, must be called before Stop()
+    void AddArg(const char* key, double value)
+    {
+        m_Args.emplace_back(key, value);
+    }
+
 private:
     const char* m_Name;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_StartTimepoint;
     bool m_Stopped;
     const char* m_Category;
+    std::vector<std::pair<std::string, double>> m_Args;
 };
 
 
@@ -170,6 +199,7 @@ void SaveProfilingData(const std::string& filepath)
 
             file << "{";
             file << "\"cat\":\"" << result.Category << "\",";
+            WriteProfileArgs(file, result);
             file << "\"dur\":" << (result.End - result.Start) << ',';
             file << "\"name\":\"" << result.Name << "\",";
             file << "\"ph\":\"X\",";
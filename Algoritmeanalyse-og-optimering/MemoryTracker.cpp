@@ -0,0 +1,122 @@
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    std::atomic<size_t> currentBytes(0);
+    std::atomic<size_t> peakBytes(0);
+    std::atomic<size_t> baselineBytes(0);
+
+#if defined(MEMORY_TRACKING)
+    // Every block is prefixed with its size, padded so the user pointer keeps max_align_t alignment
+    const size_t HEADER_SIZE = alignof(std::max_align_t) > sizeof(size_t) ? alignof(std::max_align_t) : sizeof(size_t);
+
+    void* TrackedAllocate(size_t size) {
+        void* block = std::malloc(size + HEADER_SIZE);
+        if (!block)
+            return nullptr;
+
+        *static_cast<size_t*>(block) = size;
+        MemoryTracker::RecordAllocation(size);
+        return static_cast<char*>(block) + HEADER_SIZE;
+    }
+
+    void TrackedFree(void* pointer) {
+        if (!pointer)
+            return;
+
+        void* block = static_cast<char*>(pointer) - HEADER_SIZE;
+        MemoryTracker::RecordDeallocation(*static_cast<size_t*>(block));
+        std::free(block);
+    }
+
+    void* ThrowingAllocate(size_t size) {
+        void* pointer = TrackedAllocate(size == 0 ? 1 : size);
+        if (!pointer)
+            throw std::bad_alloc();
+        return pointer;
+    }
+#endif
+}
+
+bool MemoryTracker::Enabled() {
+#if defined(MEMORY_TRACKING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t MemoryTracker::CurrentBytes() {
+    return currentBytes.load(std::memory_order_relaxed);
+}
+
+size_t MemoryTracker::PeakBytes() {
+    size_t peak = peakBytes.load(std::memory_order_relaxed);
+    size_t baseline = baselineBytes.load(std::memory_order_relaxed);
+    return peak > baseline ? peak - baseline : 0;
+}
+
+void MemoryTracker::ResetPeak() {
+    size_t current = currentBytes.load(std::memory_order_relaxed);
+    baselineBytes.store(current, std::memory_order_relaxed);
+    peakBytes.store(current, std::memory_order_relaxed);
+}
+
+size_t MemoryTracker::AvailablePhysicalBytes() {
+#if defined(_WIN32)
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (!GlobalMemoryStatusEx(&status))
+        return 0;
+    return static_cast<size_t>(status.ullAvailPhys);
+#elif defined(_SC_AVPHYS_PAGES)
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages < 0 || pageSize < 0)
+        return 0;
+    return static_cast<size_t>(pages) * static_cast<size_t>(pageSize);
+#else
+    return 0;
+#endif
+}
+
+void MemoryTracker::RecordAllocation(size_t bytes) {
+    size_t current = currentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (current > peak && !peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryTracker::RecordDeallocation(size_t bytes) {
+    currentBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+#if defined(MEMORY_TRACKING)
+// Replaced global allocation functions
+void* operator new(size_t size) { return ThrowingAllocate(size); }
+void* operator new[](size_t size) { return ThrowingAllocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size == 0 ? 1 : size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size == 0 ? 1 : size); }
+
+void operator delete(void* pointer) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { TrackedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { TrackedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { TrackedFree(pointer); }
+#endif
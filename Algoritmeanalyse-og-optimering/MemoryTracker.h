@@ -0,0 +1,43 @@
+//
+// Heap usage tracker for the benchmarks.
+//
+// Built with MEMORY_TRACKING defined (/DMEMORY_TRACKING or -DMEMORY_TRACKING), MemoryTracker.cpp replaces the global
+// operator new/delete so every C++ heap allocation in the program is counted. The counting costs every allocation a
+// size header and atomic updates, so it is off by default and timing runs keep the plain allocator; without it
+// Enabled() is false and nothing is counted.
+//
+// Usage:
+//
+// MemoryTracker::ResetPeak();                        // Start measuring from the current heap level
+// sorting::merge_sort(data);
+// size_t peak = MemoryTracker::PeakBytes();          // Highest extra heap usage since ResetPeak()
+//
+// Benchmarks only report peak_bytes when MemoryTracker::Enabled(), run a MEMORY_TRACKING build for the memory
+// numbers and a regular build for the timings.
+//
+#pragma once
+
+#include <cstddef>
+
+class MemoryTracker
+{
+public:
+    // True when the build counts allocations (MEMORY_TRACKING), the byte counts below are 0 otherwise
+    static bool Enabled();
+
+    // Live heap bytes allocated through operator new
+    static size_t CurrentBytes();
+
+    // Highest number of live heap bytes above the level at the last ResetPeak()
+    static size_t PeakBytes();
+
+    // Makes the current heap level the new baseline for PeakBytes()
+    static void ResetPeak();
+
+    // Physical memory the OS could hand out right now, 0 if it can't be queried
+    static size_t AvailablePhysicalBytes();
+
+    // Called by the replaced operator new/delete
+    static void RecordAllocation(size_t bytes);
+    static void RecordDeallocation(size_t bytes);
+};
@@ -0,0 +1,214 @@
+//
+// Work-stealing thread pool used by the parallel sorting algorithms.
+//
+// Every worker owns a deque of tasks. A worker pushes and pops its own tasks at the back (LIFO, so the
+// most recently split - and smallest - piece of work stays hot in its cache), and when it runs dry it
+// steals from the front of the other deques (FIFO, so thieves take the oldest and biggest pieces).
+//
+// Usage:
+//
+// ThreadPool pool(8);                         // 8 threads in total: 7 workers + the calling thread
+// {
+//     TaskGroup group(pool);
+//     group.Run([&] { SortLeftHalf(); });     // Forked as a task that any thread may steal
+//     SortRightHalf();                        // Done inline by the current thread
+//     group.Wait();                           // Helps executing pending tasks until the group is done
+// }
+//
+// TaskGroup::Wait() never blocks while there is work in the pool, so nested fork/join recursion
+// (a task that itself spawns and waits on tasks) cannot deadlock.
+//
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    // numThreads counts the calling thread, which works while it waits on a TaskGroup
+    explicit ThreadPool(unsigned int numThreads)
+        : m_Pending(0), m_Stop(false)
+    {
+        if (numThreads == 0)
+            numThreads = 1;
+
+        // One deque per worker plus one shared deque for threads outside the pool
+        for (unsigned int i = 0; i < numThreads; ++i)
+            m_Queues.emplace_back(new WorkQueue());
+
+        for (unsigned int i = 0; i + 1 < numThreads; ++i)
+            m_Workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_Stop = true;
+        }
+        m_WakeUp.notify_all();
+
+        for (std::thread& worker : m_Workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned int Size() const
+    {
+        return static_cast<unsigned int>(m_Queues.size());
+    }
+
+    void Submit(std::function<void()> task)
+    {
+        {
+            WorkQueue& queue = *m_Queues[OwnQueueIndex()];
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            queue.Tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_Pending.fetch_add(1);
+        }
+        m_WakeUp.notify_one();
+    }
+
+    // Runs one pending task (own queue first, then stealing). Returns false if there was nothing to do.
+    bool RunPendingTask()
+    {
+        std::function<void()> task;
+        if (!PopTask(task))
+            return false;
+
+        task();
+        return true;
+    }
+
+private:
+    struct WorkQueue
+    {
+        std::mutex Mutex;
+        std::deque<std::function<void()>> Tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> m_Queues; // [0, n-1) workers, n-1 = threads outside the pool
+    std::vector<std::thread> m_Workers;
+    std::atomic<int> m_Pending;                       // Tasks pushed but not yet popped
+    std::mutex m_SleepMutex;
+    std::condition_variable m_WakeUp;
+    bool m_Stop;
+
+    // Pool and worker index of the current thread (nullptr for threads outside any pool)
+    static ThreadPool*& CurrentPool()
+    {
+        thread_local ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    static unsigned int& CurrentIndex()
+    {
+        thread_local unsigned int index = 0;
+        return index;
+    }
+
+    unsigned int OwnQueueIndex() const
+    {
+        return CurrentPool() == this ? CurrentIndex() : Size() - 1;
+    }
+
+    bool PopTask(std::function<void()>& task)
+    {
+        const unsigned int own = OwnQueueIndex();
+
+        // Own tasks are taken from the back
+        {
+            WorkQueue& queue = *m_Queues[own];
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            if (!queue.Tasks.empty()) {
+                task = std::move(queue.Tasks.back());
+                queue.Tasks.pop_back();
+                m_Pending.fetch_sub(1);
+                return true;
+            }
+        }
+
+        // Steal from the front of the other queues, starting with the neighbour
+        for (unsigned int offset = 1; offset < Size(); ++offset) {
+            WorkQueue& queue = *m_Queues[(own + offset) % Size()];
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            if (!queue.Tasks.empty()) {
+                task = std::move(queue.Tasks.front());
+                queue.Tasks.pop_front();
+                m_Pending.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkerLoop(unsigned int index)
+    {
+        CurrentPool() = this;
+        CurrentIndex() = index;
+
+        while (true) {
+            if (RunPendingTask())
+                continue;
+
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            m_WakeUp.wait(lock, [this] { return m_Stop || m_Pending.load() > 0; });
+            if (m_Stop)
+                return;
+        }
+    }
+};
+
+// A set of tasks forked on a ThreadPool that can be joined together
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool& pool)
+        : m_Pool(pool), m_Outstanding(0)
+    {
+    }
+
+    ~TaskGroup()
+    {
+        Wait();
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <typename Function>
+    void Run(Function&& function)
+    {
+        m_Outstanding.fetch_add(1, std::memory_order_relaxed);
+        m_Pool.Submit([this, function]() mutable {
+            function();
+            m_Outstanding.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // Executes pending pool tasks until every task of this group has finished
+    void Wait()
+    {
+        while (m_Outstanding.load(std::memory_order_acquire) > 0) {
+            if (!m_Pool.RunPendingTask())
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    ThreadPool& m_Pool;
+    std::atomic<int> m_Outstanding;
+};
@@ -0,0 +1,368 @@
+#include "async_io.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace sorting {
+
+    // Positional File implementation
+    const std::size_t MAX_TRANSFER = std::size_t(1) << 30;     // Largest single read or write handed to the OS
+
+    PositionalFile::~PositionalFile() {
+        close();
+    }
+
+#if defined(_WIN32)
+    bool PositionalFile::open_read(const std::string& path) {
+        close();
+        HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        m_Handle = handle == INVALID_HANDLE_VALUE ? nullptr : handle;
+        return is_open();
+    }
+
+    bool PositionalFile::open_write(const std::string& path) {
+        close();
+        HANDLE handle = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        m_Handle = handle == INVALID_HANDLE_VALUE ? nullptr : handle;
+        return is_open();
+    }
+
+    bool PositionalFile::is_open() const {
+        return m_Handle != nullptr;
+    }
+
+    void PositionalFile::close() {
+        if (m_Handle)
+            CloseHandle(m_Handle);
+        m_Handle = nullptr;
+    }
+
+    // A synchronous handle with an OVERLAPPED offset reads and writes at that offset, the Windows pread/pwrite
+    std::int64_t PositionalFile::read_at(void* data, std::size_t bytes, std::uint64_t offset) {
+        std::size_t done = 0;
+        while (done < bytes) {
+            OVERLAPPED position = {};
+            position.Offset = static_cast<DWORD>(offset + done);
+            position.OffsetHigh = static_cast<DWORD>((offset + done) >> 32);
+            DWORD moved = 0;
+            DWORD chunk = static_cast<DWORD>(std::min(bytes - done, MAX_TRANSFER));
+            if (!ReadFile(m_Handle, static_cast<char*>(data) + done, chunk, &moved, &position))
+                return GetLastError() == ERROR_HANDLE_EOF ? static_cast<std::int64_t>(done) : -1;
+            if (moved == 0)
+                break;                                              // End of file
+            done += moved;
+        }
+        return static_cast<std::int64_t>(done);
+    }
+
+    std::int64_t PositionalFile::write_at(const void* data, std::size_t bytes, std::uint64_t offset) {
+        std::size_t done = 0;
+        while (done < bytes) {
+            OVERLAPPED position = {};
+            position.Offset = static_cast<DWORD>(offset + done);
+            position.OffsetHigh = static_cast<DWORD>((offset + done) >> 32);
+            DWORD moved = 0;
+            DWORD chunk = static_cast<DWORD>(std::min(bytes - done, MAX_TRANSFER));
+            if (!WriteFile(m_Handle, static_cast<const char*>(data) + done, chunk, &moved, &position) || moved == 0)
+                return -1;
+            done += moved;
+        }
+        return static_cast<std::int64_t>(done);
+    }
+#else
+    bool PositionalFile::open_read(const std::string& path) {
+        close();
+        m_Fd = ::open(path.c_str(), O_RDONLY);
+        return is_open();
+    }
+
+    bool PositionalFile::open_write(const std::string& path) {
+        close();
+        m_Fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        return is_open();
+    }
+
+    bool PositionalFile::is_open() const {
+        return m_Fd >= 0;
+    }
+
+    void PositionalFile::close() {
+        if (m_Fd >= 0)
+            ::close(m_Fd);
+        m_Fd = -1;
+    }
+
+    std::int64_t PositionalFile::read_at(void* data, std::size_t bytes, std::uint64_t offset) {
+        std::size_t done = 0;
+        while (done < bytes) {
+            ssize_t moved = ::pread(m_Fd, static_cast<char*>(data) + done, std::min(bytes - done, MAX_TRANSFER), static_cast<off_t>(offset + done));
+            if (moved < 0 && errno == EINTR)
+                continue;
+            if (moved < 0)
+                return -1;
+            if (moved == 0)
+                break;                                              // End of file
+            done += static_cast<std::size_t>(moved);
+        }
+        return static_cast<std::int64_t>(done);
+    }
+
+    std::int64_t PositionalFile::write_at(const void* data, std::size_t bytes, std::uint64_t offset) {
+        std::size_t done = 0;
+        while (done < bytes) {
+            ssize_t moved = ::pwrite(m_Fd, static_cast<const char*>(data) + done, std::min(bytes - done, MAX_TRANSFER), static_cast<off_t>(offset + done));
+            if (moved < 0 && errno == EINTR)
+                continue;
+            if (moved <= 0)
+                return -1;
+            done += static_cast<std::size_t>(moved);
+        }
+        return static_cast<std::int64_t>(done);
+    }
+#endif
+
+
+    // Async I/O implementation
+    double seconds_between(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    // Finishes a request whose asynchronous part moved `moved` bytes: a short transfer that did not hit the end of the
+    // file, or a request the ring rejected, is completed synchronously so callers only see full blocks or end of file
+    void complete_request(IoRequest& request, std::int64_t moved) {
+        if (moved < 0 || (static_cast<std::size_t>(moved) < request.bytes && (request.write || moved > 0))) {
+            std::size_t done = moved < 0 ? 0 : static_cast<std::size_t>(moved);
+            std::int64_t rest = request.write
+                ? request.file->write_at(request.data + done, request.bytes - done, request.offset + done)
+                : request.file->read_at(request.data + done, request.bytes - done, request.offset + done);
+            moved = rest < 0 ? -1 : static_cast<std::int64_t>(done) + rest;
+        }
+        request.result = moved;
+        request.busy_seconds = seconds_between(request.submitted, std::chrono::steady_clock::now());
+        request.pending.store(false, std::memory_order_release);
+    }
+
+#if defined(__linux__)
+    const unsigned int IO_RING_ENTRIES = 512;       // Requests in flight at once, a merge keeps one per run plus the output
+
+    // A minimal io_uring driven through the raw system calls, so the build needs no liburing
+    struct AsyncIo::Ring {
+        int fd = -1;
+        unsigned int entries = 0;
+        unsigned int in_flight = 0;
+
+        void* sq_ring = nullptr;
+        std::size_t sq_ring_size = 0;
+        void* cq_ring = nullptr;
+        std::size_t cq_ring_size = 0;
+        io_uring_sqe* sqes = nullptr;
+        std::size_t sqes_size = 0;
+
+        unsigned* sq_head = nullptr;
+        unsigned* sq_tail = nullptr;
+        unsigned* sq_mask = nullptr;
+        unsigned* sq_array = nullptr;
+        unsigned* cq_head = nullptr;
+        unsigned* cq_tail = nullptr;
+        unsigned* cq_mask = nullptr;
+        io_uring_cqe* cqes = nullptr;
+
+        ~Ring() {
+            if (sqes) munmap(sqes, sqes_size);
+            if (cq_ring && cq_ring != sq_ring) munmap(cq_ring, cq_ring_size);
+            if (sq_ring) munmap(sq_ring, sq_ring_size);
+            if (fd >= 0) ::close(fd);
+        }
+
+        // False when the kernel or a sandbox refuses io_uring, the caller then uses the pool
+        bool setup() {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            fd = static_cast<int>(syscall(__NR_io_uring_setup, IO_RING_ENTRIES, &params));
+            if (fd < 0)
+                return false;
+            entries = params.sq_entries;
+
+            // Step 1: Map the submission ring, the completion ring (often the same mapping) and the entry array
+            sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap)
+                sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+            sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            if (sq_ring == MAP_FAILED) {
+                sq_ring = nullptr;
+                return false;
+            }
+            cq_ring = single_mmap ? sq_ring : mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cq_ring == MAP_FAILED) {
+                cq_ring = nullptr;
+                return false;
+            }
+            sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            void* entries_map = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+            if (entries_map == MAP_FAILED)
+                return false;
+            sqes = static_cast<io_uring_sqe*>(entries_map);
+
+            // Step 2: Locate the ring indices inside the mappings
+            char* sq = static_cast<char*>(sq_ring);
+            char* cq = static_cast<char*>(cq_ring);
+            sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        // Queues one read or write and tells the kernel about it
+        void submit(IoRequest& request) {
+            reap();                                                     // O(1) - stamps finished requests close to their completion
+            while (in_flight >= entries)
+                wait_for_completion();
+
+            unsigned tail = *sq_tail;
+            unsigned index = tail & *sq_mask;
+            io_uring_sqe& sqe = sqes[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = request.write ? IORING_OP_WRITE : IORING_OP_READ;
+            sqe.fd = request.file->handle();
+            sqe.addr = reinterpret_cast<std::uint64_t>(request.data);
+            sqe.len = static_cast<std::uint32_t>(std::min(request.bytes, MAX_TRANSFER));   // complete_request finishes the rest
+            sqe.off = request.offset;
+            sqe.user_data = reinterpret_cast<std::uint64_t>(&request);
+            sq_array[index] = index;
+            __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+            ++in_flight;
+
+            while (syscall(__NR_io_uring_enter, fd, 1, 0, 0, nullptr, 0) < 0 && errno == EINTR) {
+            }
+        }
+
+        // Completes every request the kernel has finished, returns how many
+        unsigned int reap() {
+            unsigned int reaped = 0;
+            unsigned head = *cq_head;
+            while (head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& cqe = cqes[head & *cq_mask];
+                complete_request(*reinterpret_cast<IoRequest*>(cqe.user_data), cqe.res);
+                ++head;
+                ++reaped;
+            }
+            __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+            in_flight -= reaped;
+            return reaped;
+        }
+
+        // Blocks in the kernel until at least one request completes
+        void wait_for_completion() {
+            while (reap() == 0)
+                syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        }
+    };
+#else
+    struct AsyncIo::Ring {
+    };
+#endif
+
+    AsyncIo::AsyncIo(ThreadPool& pool)
+        : m_Pool(pool) {
+#if defined(__linux__)
+        std::unique_ptr<Ring> ring(new Ring());
+        if (ring->setup())
+            m_Ring = std::move(ring);
+#endif
+    }
+
+    AsyncIo::~AsyncIo() = default;
+
+    bool AsyncIo::uses_io_uring() const {
+        return m_Ring != nullptr;
+    }
+
+    void AsyncIo::read(PositionalFile& file, void* data, std::size_t bytes, std::uint64_t offset, IoRequest& request) {
+        request.write = false;
+        request.file = &file;
+        request.data = static_cast<char*>(data);
+        request.bytes = bytes;
+        request.offset = offset;
+        submit(request);
+    }
+
+    void AsyncIo::write(PositionalFile& file, const void* data, std::size_t bytes, std::uint64_t offset, IoRequest& request) {
+        request.write = true;
+        request.file = &file;
+        request.data = static_cast<char*>(const_cast<void*>(data));     // Only read from for a write
+        request.bytes = bytes;
+        request.offset = offset;
+        submit(request);
+    }
+
+    void AsyncIo::submit(IoRequest& request) {
+        request.active = true;
+        request.pending.store(true, std::memory_order_relaxed);
+        request.submitted = std::chrono::steady_clock::now();
+
+#if defined(__linux__)
+        if (m_Ring) {
+            m_Ring->submit(request);
+            return;
+        }
+#endif
+
+        // Fallback: a blocking positional transfer on a pool thread, the offset travels with the request
+        IoRequest* pending = &request;
+        m_Pool.Submit([pending]() {
+            auto start = std::chrono::steady_clock::now();
+            std::int64_t moved = pending->write
+                ? pending->file->write_at(pending->data, pending->bytes, pending->offset)
+                : pending->file->read_at(pending->data, pending->bytes, pending->offset);
+            pending->submitted = start;                                 // Busy time is the transfer itself, not the queueing
+            complete_request(*pending, moved);
+        });
+    }
+
+    bool AsyncIo::wait(IoRequest& request) {
+        if (!request.active)
+            return false;
+
+        while (request.pending.load(std::memory_order_acquire)) {
+#if defined(__linux__)
+            if (m_Ring) {
+                m_Ring->wait_for_completion();
+                continue;
+            }
+#endif
+            if (!m_Pool.RunPendingTask())
+                std::this_thread::yield();
+        }
+        request.active = false;
+        return true;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class ThreadPool;
+
+namespace sorting {
+    // A file for positional I/O: every read and write names its own offset, so requests in flight share no file position
+    class PositionalFile {
+    public:
+        PositionalFile() = default;
+        ~PositionalFile();
+
+        PositionalFile(const PositionalFile&) = delete;
+        PositionalFile& operator=(const PositionalFile&) = delete;
+
+        bool open_read(const std::string& path);
+        bool open_write(const std::string& path);      // Creates or truncates the file
+        bool is_open() const;
+        void close();
+
+        // Reads or writes all bytes at offset, fewer only at the end of the file. Returns the bytes moved, -1 on error.
+        std::int64_t read_at(void* data, std::size_t bytes, std::uint64_t offset);
+        std::int64_t write_at(const void* data, std::size_t bytes, std::uint64_t offset);
+
+#if defined(_WIN32)
+        void* handle() const { return m_Handle; }
+#else
+        int handle() const { return m_Fd; }
+#endif
+
+    private:
+#if defined(_WIN32)
+        void* m_Handle = nullptr;
+#else
+        int m_Fd = -1;
+#endif
+    };
+
+    // One read or write handed to AsyncIo, it must stay in place until AsyncIo::wait returns
+    struct IoRequest {
+        std::atomic<bool> pending{ false };
+        bool active = false;                // Submitted and not waited for yet, only touched by the submitting thread
+        bool write = false;
+        PositionalFile* file = nullptr;
+        char* data = nullptr;
+        std::size_t bytes = 0;
+        std::uint64_t offset = 0;
+        std::int64_t result = 0;            // Bytes moved, -1 on error
+        double busy_seconds = 0.0;          // Transfer time on the pool, submission to seen completion with io_uring
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    // Overlaps reads and writes with computation. On Linux the requests go through an io_uring when the kernel
+    // allows one; otherwise, and on other systems, every request runs pread/pwrite (ReadFile/WriteFile at an
+    // offset on Windows) as a task on the pool. One thread submits and waits, the pool may be shared.
+    class AsyncIo {
+    public:
+        explicit AsyncIo(ThreadPool& pool);
+        ~AsyncIo();
+
+        AsyncIo(const AsyncIo&) = delete;
+        AsyncIo& operator=(const AsyncIo&) = delete;
+
+        bool uses_io_uring() const;
+
+        void read(PositionalFile& file, void* data, std::size_t bytes, std::uint64_t offset, IoRequest& request);
+        void write(PositionalFile& file, const void* data, std::size_t bytes, std::uint64_t offset, IoRequest& request);
+
+        // Blocks until request has completed, false if nothing was submitted since the last wait
+        bool wait(IoRequest& request);
+
+    private:
+        void submit(IoRequest& request);
+
+        ThreadPool& m_Pool;
+        struct Ring;
+        std::unique_ptr<Ring> m_Ring;       // Null when requests go to the pool
+    };
+}
+
+#endif // ASYNC_IO_H
@@ -0,0 +1,430 @@
+#include "external_sort.h"
+#include "async_io.h"
+#include "sorting.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace sorting {
+
+    // External Merge Sort implementation
+    const std::size_t EXTERNAL_SORT_MIN_BLOCK = 64 * 1024;     // Smallest read/write block per run during a merge, in bytes
+    const unsigned int EXTERNAL_SORT_IO_THREADS = 2;            // Pool threads for reads and writes without io_uring, the caller sorts and merges
+
+    double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Buffered sequential reader over one sorted run, every block is read at an explicit offset.
+    // With async I/O the next block is read into a spare buffer while the current one is merged.
+    struct RunReader {
+        PositionalFile file;
+        std::vector<int> block;
+        std::vector<int> spare;
+        std::uint64_t offset = 0;       // Bytes of the run consumed by completed reads
+        std::size_t pos = 0;
+        std::size_t count = 0;
+        bool failed = false;
+        double busy_seconds = 0.0;      // Time spent inside reads
+        double stall_seconds = 0.0;     // Time the merge waited for this run
+        AsyncIo* io = nullptr;
+        IoRequest request;
+
+        ~RunReader() {
+            if (io)
+                io->wait(request);
+        }
+
+        // Accounts for a completed read of bytes at offset, returns the ints it delivered
+        std::size_t consume(std::int64_t bytes) {
+            if (bytes < 0 || bytes % sizeof(int) != 0) {
+                failed = true;
+                return 0;
+            }
+            offset += static_cast<std::uint64_t>(bytes);
+            return static_cast<std::size_t>(bytes) / sizeof(int);
+        }
+
+        // Starts reading the block after the current one
+        void prefetch() {
+            io->read(file, spare.data(), spare.size() * sizeof(int), offset, request);
+        }
+
+        // Makes the next block current, false at the end of the run or on a read error
+        bool refill() {
+            auto start = std::chrono::steady_clock::now();
+            if (io) {
+                io->wait(request);
+                busy_seconds += request.busy_seconds;
+                std::swap(block, spare);
+                count = consume(request.result);
+            }
+            else {
+                auto read_start = std::chrono::steady_clock::now();
+                count = consume(file.read_at(block.data(), block.size() * sizeof(int), offset));
+                busy_seconds += seconds_since(read_start);
+            }
+            pos = 0;
+            bool ok = count > 0 && !failed;
+            if (io && ok)
+                prefetch();
+            stall_seconds += seconds_since(start);
+            return ok;
+        }
+    };
+
+    // Buffered sequential writer, flushes one block at a time at the next offset.
+    // With async I/O a full block is written in the background while the next one fills.
+    struct RunWriter {
+        PositionalFile file;
+        std::vector<int> block;
+        std::vector<int> spare;
+        std::size_t count = 0;
+        std::uint64_t offset = 0;       // Bytes written or handed to a write so far
+        bool failed = false;
+        double busy_seconds = 0.0;
+        double stall_seconds = 0.0;
+        AsyncIo* io = nullptr;
+        IoRequest request;
+
+        ~RunWriter() {
+            if (io)
+                io->wait(request);
+        }
+
+        // Waits for the write in flight, if any, and records how it went
+        void finish_write() {
+            if (io && io->wait(request)) {
+                busy_seconds += request.busy_seconds;
+                failed = failed || request.result != static_cast<std::int64_t>(request.bytes);
+            }
+        }
+
+        bool flush() {
+            auto start = std::chrono::steady_clock::now();
+            finish_write();
+            auto write_start = std::chrono::steady_clock::now();
+            const std::size_t bytes = count * sizeof(int);
+            failed = failed || file.write_at(block.data(), bytes, offset) != static_cast<std::int64_t>(bytes);
+            busy_seconds += seconds_since(write_start);
+            offset += bytes;
+            count = 0;
+            stall_seconds += seconds_since(start);
+            return !failed;
+        }
+
+        bool push(int value) {
+            block[count++] = value;
+            if (count < block.size())
+                return true;
+            if (!io)
+                return flush();
+
+            // Hand the full block to a write and keep filling the spare
+            auto start = std::chrono::steady_clock::now();
+            finish_write();
+            stall_seconds += seconds_since(start);
+            if (failed)
+                return false;
+            std::swap(block, spare);
+            const std::size_t bytes = count * sizeof(int);
+            io->write(file, spare.data(), bytes, offset, request);
+            offset += bytes;
+            count = 0;
+            return true;
+        }
+    };
+
+    std::string run_path(const std::string& output_path, int pass, std::size_t index) {
+        return output_path + ".run" + std::to_string(pass) + "_" + std::to_string(index) + ".tmp";
+    }
+
+    void remove_runs(const std::vector<std::string>& paths) {
+        for (const std::string& path : paths)
+            std::remove(path.c_str());
+    }
+
+    // Reads up to chunk_ints ints into chunk, false on a read error or a trailing partial int
+    bool read_chunk(std::ifstream& input, std::vector<int>& chunk, std::size_t chunk_ints, double& busy_seconds) {
+        auto start = std::chrono::steady_clock::now();
+        chunk.resize(chunk_ints);
+        input.read(reinterpret_cast<char*>(chunk.data()), chunk_ints * sizeof(int));
+        std::size_t bytes = static_cast<std::size_t>(input.gcount());
+        chunk.resize(bytes / sizeof(int));
+        busy_seconds += seconds_since(start);
+        return !input.bad() && bytes % sizeof(int) == 0;
+    }
+
+    bool write_chunk(const std::string& path, const std::vector<int>& chunk, double& busy_seconds) {
+        auto start = std::chrono::steady_clock::now();
+        std::ofstream run(path, std::ios::binary | std::ios::trunc);
+        run.write(reinterpret_cast<const char*>(chunk.data()), chunk.size() * sizeof(int));
+        busy_seconds += seconds_since(start);
+        return static_cast<bool>(run);
+    }
+
+    void sort_chunk(std::vector<int>& chunk, ExternalSortStats& stats) {
+        auto start = std::chrono::steady_clock::now();
+        radix_sort(chunk);
+        stats.elements += chunk.size();
+        stats.sort_busy_seconds += seconds_since(start);
+    }
+
+    // Reads the input chunk by chunk, sorts each chunk in memory and spills it as a run.
+    // A single chunk is written straight to output_path and no runs are returned.
+    bool create_runs(const std::string& input_path, const std::string& output_path, std::size_t memory_bytes,
+                     std::vector<std::string>& runs, ExternalSortStats& stats) {
+        std::ifstream input(input_path, std::ios::binary);
+        if (!input)
+            return false;
+
+        // radix_sort needs a scratch buffer as large as the chunk, so the chunk gets half the budget
+        const std::size_t chunk_ints = std::max<std::size_t>(memory_bytes / (2 * sizeof(int)), EXTERNAL_SORT_MIN_BLOCK / sizeof(int));
+        std::vector<int> chunk;
+
+        while (true) {
+            // Step 1: Fill the chunk with the next piece of the input
+            if (!read_chunk(input, chunk, chunk_ints, stats.read_busy_seconds))        // O(chunk)
+                return false;
+            if (chunk.empty())
+                break;
+
+            // Step 2: Sort it with the in-memory engine
+            sort_chunk(chunk, stats);                                                    // O(chunk)
+
+            // Step 3: Spill it, directly to the output if it was the whole input
+            bool only_chunk = runs.empty() && input.peek() == std::char_traits<char>::eof();
+            std::string path = only_chunk ? output_path : run_path(output_path, 0, runs.size());
+            if (!only_chunk)
+                runs.push_back(path);
+            if (!write_chunk(path, chunk, stats.write_busy_seconds))                    // O(chunk)
+                return false;
+            if (only_chunk)
+                break;
+        }
+
+        // An empty input still produces an (empty) output file
+        if (stats.elements == 0) {
+            std::ofstream output(output_path, std::ios::binary | std::ios::trunc);
+            return static_cast<bool>(output);
+        }
+        return true;
+    }
+
+    // Same as create_runs, but chunk i is sorted while chunk i+1 is read and chunk i-1 is written as async requests
+    bool create_runs_pipelined(const std::string& input_path, const std::string& output_path, std::size_t memory_bytes,
+                               std::vector<std::string>& runs, ExternalSortStats& stats, AsyncIo& io) {
+        PositionalFile input;
+        if (!input.open_read(input_path))
+            return false;
+
+        // Three chunks are in flight plus the radix_sort scratch buffer, so each chunk gets a quarter of the budget
+        const std::size_t chunk_ints = std::max<std::size_t>(memory_bytes / (4 * sizeof(int)), EXTERNAL_SORT_MIN_BLOCK / sizeof(int));
+        std::vector<int> next(chunk_ints);     // Being read
+        std::vector<int> current;               // Being sorted
+        std::vector<int> previous;              // Being written
+        std::string previous_path;
+        PositionalFile previous_file;
+        std::uint64_t input_offset = 0;
+        IoRequest read_request;
+        IoRequest write_request;
+
+        // Records a completed read of the next chunk, false on an error or a trailing partial int
+        auto finish_read = [&]() {
+            io.wait(read_request);
+            stats.read_busy_seconds += read_request.busy_seconds;
+            if (read_request.result < 0 || read_request.result % sizeof(int) != 0)
+                return false;
+            next.resize(static_cast<std::size_t>(read_request.result) / sizeof(int));
+            input_offset += static_cast<std::uint64_t>(read_request.result);
+            return true;
+        };
+
+        io.read(input, next.data(), chunk_ints * sizeof(int), input_offset, read_request);
+        bool read_ok = finish_read();
+        bool write_ok = true;
+
+        while (read_ok && write_ok && !next.empty()) {
+            std::swap(current, next);
+
+            // Step 1: Read ahead and write behind as async requests, sort on this thread
+            next.resize(chunk_ints);
+            io.read(input, next.data(), chunk_ints * sizeof(int), input_offset, read_request);
+            if (!previous.empty()) {
+                write_ok = previous_file.open_write(previous_path);
+                if (write_ok)
+                    io.write(previous_file, previous.data(), previous.size() * sizeof(int), 0, write_request);
+            }
+            sort_chunk(current, stats);                                                   // O(chunk)
+            read_ok = finish_read();
+            if (io.wait(write_request)) {
+                stats.write_busy_seconds += write_request.busy_seconds;
+                write_ok = write_request.result == static_cast<std::int64_t>(write_request.bytes);
+                previous_file.close();
+            }
+
+            // Step 2: The sorted chunk is written next round, directly to the output if it was the whole input
+            bool only_chunk = runs.empty() && next.empty();
+            previous_path = only_chunk ? output_path : run_path(output_path, 0, runs.size());
+            if (!only_chunk)
+                runs.push_back(previous_path);
+            std::swap(previous, current);
+            current.clear();
+        }
+
+        // Step 3: Write the last chunk
+        if (read_ok && write_ok && !previous.empty()) {
+            auto start = std::chrono::steady_clock::now();
+            write_ok = previous_file.open_write(previous_path)
+                && previous_file.write_at(previous.data(), previous.size() * sizeof(int), 0) == static_cast<std::int64_t>(previous.size() * sizeof(int));
+            previous_file.close();
+            stats.write_busy_seconds += seconds_since(start);
+        }
+        if (!read_ok || !write_ok)
+            return false;
+
+        if (stats.elements == 0) {
+            std::ofstream output(output_path, std::ios::binary | std::ios::trunc);
+            return static_cast<bool>(output);
+        }
+        return true;
+    }
+
+    // k-way merges the sorted runs in inputs into output_path with a binary heap of run heads.
+    // With async I/O every run and the output are double buffered.
+    bool merge_runs(const std::vector<std::string>& inputs, const std::string& output_path, std::size_t memory_bytes,
+                    ExternalSortStats& stats, AsyncIo* io) {
+        auto start = std::chrono::steady_clock::now();
+
+        // Step 1: Split the budget evenly between the read blocks and the write blocks
+        const std::size_t buffers = (inputs.size() + 1) * (io ? 2 : 1);
+        const std::size_t block_ints = std::max<std::size_t>(memory_bytes / buffers, EXTERNAL_SORT_MIN_BLOCK) / sizeof(int);
+
+        RunWriter writer;
+        writer.io = io;
+        writer.block.resize(block_ints);
+        if (io)
+            writer.spare.resize(block_ints);
+        if (!writer.file.open_write(output_path))
+            return false;
+
+        // Declared after the writer so every pending read has finished before anything is destroyed
+        std::vector<RunReader> readers(inputs.size());
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            readers[i].io = io;
+            readers[i].block.resize(block_ints);
+            if (!readers[i].file.open_read(inputs[i]))
+                return false;
+            if (io) {
+                readers[i].spare.resize(block_ints);
+                readers[i].prefetch();
+            }
+        }
+
+        // Step 2: Seed the heap with the first element of every run
+        typedef std::pair<int, std::size_t> Head;   // Value and the run it came from
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap;
+        for (std::size_t i = 0; i < readers.size(); ++i) {
+            if (readers[i].refill())
+                heap.push(Head(readers[i].block[readers[i].pos++], i));
+            else if (readers[i].failed)
+                return false;
+        }
+
+        // Step 3: Repeatedly move the smallest head to the output and refill from its run
+        bool ok = true;
+        while (ok && !heap.empty()) {                                       // O(n log k)
+            Head head = heap.top();
+            heap.pop();
+            ok = writer.push(head.first);
+
+            RunReader& reader = readers[head.second];
+            if (reader.pos == reader.count && !reader.refill()) {
+                ok = ok && !reader.failed;
+                continue;                                                   // Run exhausted
+            }
+            heap.push(Head(reader.block[reader.pos++], head.second));
+        }
+        ok = ok && writer.flush();
+
+        // Everything not spent waiting on I/O was merge work
+        double stall_seconds = writer.stall_seconds;
+        stats.write_busy_seconds += writer.busy_seconds;
+        for (const RunReader& reader : readers) {
+            stall_seconds += reader.stall_seconds;
+            stats.read_busy_seconds += reader.busy_seconds;
+        }
+        stats.merge_busy_seconds += std::max(0.0, seconds_since(start) - stall_seconds);
+        return ok;
+    }
+
+    // Creates the runs and merges them, overlapping I/O with sorting and merging when async I/O is given
+    bool run_external_sort(const std::string& input_path, const std::string& output_path, std::size_t memory_bytes,
+                           ExternalSortStats* stats, AsyncIo* io) {
+        ExternalSortStats local;
+        ExternalSortStats& result = stats ? *stats : local;
+        result = ExternalSortStats();
+
+        // Step 1: Spill sorted runs
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::string> runs;
+        bool ok = io ? create_runs_pipelined(input_path, output_path, memory_bytes, runs, result, *io)
+                       : create_runs(input_path, output_path, memory_bytes, runs, result);
+        result.runs = runs.size();
+        result.run_seconds = seconds_since(start);
+        if (!ok) {
+            remove_runs(runs);
+            return false;
+        }
+
+        // Step 2: Merge up to fan_in runs at a time until one run is left, the last pass writes the output.
+        // A merge holds a block per run plus one for the output, two each when double buffered, and no block may shrink
+        // below EXTERNAL_SORT_MIN_BLOCK, so the fan-in is what the budget affords at that size.
+        start = std::chrono::steady_clock::now();
+        const std::size_t blocks_per_run = io ? 2 : 1;
+        const std::size_t fan_in = std::min(EXTERNAL_SORT_MAX_FAN_IN, std::max<std::size_t>(3, memory_bytes / (blocks_per_run * EXTERNAL_SORT_MIN_BLOCK)) - 1);
+        while (!runs.empty()) {                                             // O(log_k(runs)) passes
+            ++result.merge_passes;
+            bool last_pass = runs.size() <= fan_in;
+            std::vector<std::string> next;
+
+            for (std::size_t first = 0; first < runs.size(); first += fan_in) {
+                std::vector<std::string> group(runs.begin() + first, runs.begin() + std::min(first + fan_in, runs.size()));
+                std::string path = last_pass ? output_path : run_path(output_path, result.merge_passes, next.size());
+                if (!last_pass)
+                    next.push_back(path);
+
+                ok = merge_runs(group, path, memory_bytes, result, io);
+                remove_runs(group);
+                if (!ok) {
+                    remove_runs(std::vector<std::string>(runs.begin() + std::min(first + fan_in, runs.size()), runs.end()));
+                    remove_runs(next);
+                    return false;
+                }
+            }
+
+            runs = last_pass ? std::vector<std::string>() : next;
+        }
+        result.merge_seconds = seconds_since(start);
+
+        return true;
+    }
+
+    bool external_sort(const std::string& input_path, const std::string& output_path, std::size_t memory_bytes,
+                       ExternalSortStats* stats) {
+        return run_external_sort(input_path, output_path, memory_bytes, stats, nullptr);
+    }
+
+    bool pipelined_external_sort(const std::string& input_path, const std::string& output_path, std::size_t memory_bytes,
+                                 ExternalSortStats* stats) {
+        ThreadPool pool(EXTERNAL_SORT_IO_THREADS + 1);
+        AsyncIo io(pool);
+        return run_external_sort(input_path, output_path, memory_bytes, stats, &io);
+    }
+}
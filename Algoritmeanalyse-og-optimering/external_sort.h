@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace sorting {
+    // Most sorted runs merged at once, more runs are merged in several passes
+    const std::size_t EXTERNAL_SORT_MAX_FAN_IN = 256;
+
+    // What an external sort did, filled in by external_sort
+    struct ExternalSortStats {
+        std::uint64_t elements = 0;     // Ints in the input file
+        std::size_t runs = 0;           // Sorted runs spilled to temp files
+        int merge_passes = 0;           // Passes over the data after run creation
+        double run_seconds = 0.0;       // Reading, sorting and spilling the runs
+        double merge_seconds = 0.0;     // Merging the runs into the output file
+
+        // Time each stage spent working (not waiting), summed over both phases.
+        // Divided by run_seconds + merge_seconds this is the stage's utilization, the busiest stage bounds throughput.
+        double read_busy_seconds = 0.0;
+        double sort_busy_seconds = 0.0;
+        double merge_busy_seconds = 0.0;
+        double write_busy_seconds = 0.0;
+    };
+
+    // Function to sort a binary file of native-endian 32-bit ints that may be larger than RAM.
+    // The input is read in chunks of about memory_bytes, each chunk is sorted in memory and spilled to
+    // a temp file next to output_path, and the runs are k-way merged with large buffered reads and writes.
+    // Returns false if a file can't be opened, read or written, temp files are removed either way.
+    bool external_sort(const std::string& input_path, const std::string& output_path, std::size_t memory_bytes,
+                       ExternalSortStats* stats = nullptr);
+
+    // Function to perform the same external sort as an overlapped pipeline: while chunk i is sorted, chunk i+1 is
+    // read and chunk i-1 is written, and during merges every run and the output are double buffered so the next
+    // block is read (or the last block written) while the current one is merged. The reads and writes go through an
+    // io_uring on Linux and otherwise run as pread/pwrite tasks at explicit offsets on a small thread pool (AsyncIo).
+    // Uses the same memory budget, split over twice as many buffers.
+    bool pipelined_external_sort(const std::string& input_path, const std::string& output_path, std::size_t memory_bytes,
+                                 ExternalSortStats* stats = nullptr);
+}
+
+#endif // EXTERNAL_SORT_H
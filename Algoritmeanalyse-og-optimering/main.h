@@ -6,9 +6,19 @@
 #include <algorithm>
 #include <random>
 #include <numeric>
+#include <queue>
+#include <thread>
+#include <climits>
+#include <cstdio>
+#include <functional>
+#include <limits>
 #include "raylib/raylib-5.5_win64_msvc16/include/raylib.h"
 #include "Instrumentor.h"
+#include "MemoryTracker.h"
 #include "sorting.h"
+#include "sorting_generic.h"
+#include "sorting_simd.h"
+#include "external_sort.h"
 #include "searching.h"
 #include "Visualizer.h"
 
@@ -32,7 +42,35 @@ void UpdateProgress(BenchmarkProgress& progress, const std::string& algorithm,
 void AddResult(BenchmarkProgress& progress, const std::string& result);
 
 
-void RunSortingBenchmarks(int num_runs, int initial_size, int size_increment);
+// num_threads = 0 uses every hardware thread for the parallel sorts
+void RunSortingBenchmarks(int num_runs, int initial_size, int size_increment, unsigned int num_threads = 0);
+// Strong scaling: the parallel sorts on the same size input with 1 to max_threads threads (0 = every hardware thread),
+// recorded with their speedup and efficiency over one thread
+void RunScalingBenchmarks(int size, unsigned int max_threads = 0);
+// Selects the k smallest of size elements for every k in ks with intro_select, partial_sort and StreamingTopK,
+// with std::nth_element and a full pdq_sort as references
+void RunSelectionBenchmarks(int size, const std::vector<int>& ks);
+// Times merge_sort, buffered merge_sort and cache_blocked_merge_sort for sizes doubling from initial_size to
+// max_size, tagging every run with the cache level its data and merge buffer fit in (4 = DRAM)
+void RunCacheBlockedBenchmarks(int initial_size, int max_size);
+// Times merge_sort, buffered merge_sort and in_place_merge_sort on random and few-unique data for sizes doubling
+// from initial_size to max_size, recording the peak heap bytes of every sort in MEMORY_TRACKING builds
+void RunInPlaceMergeBenchmarks(int initial_size, int max_size);
+// Sorts about total_size elements split into segments with lengths uniform in each [min, max] range, as one
+// merge_sort call per array and with segmented_sort on one and on num_threads threads (0 = every hardware thread)
+void RunSegmentedSortBenchmarks(int total_size, const std::vector<std::pair<int, int>>& length_ranges, unsigned int num_threads = 0);
+// Sorts an int key column with a 64-bit payload as SoA (sort_by_key), AoS (sort_records_by_key) and
+// argsort + gather, each with the radix and merge backend, for sizes doubling from initial_size to max_size
+void RunKeyValueBenchmarks(int initial_size, int max_size);
+// Times scalar_merge against bitonic_merge on two sorted halves, throughput is recorded as gb_per_s
+void RunMergeBenchmarks(int num_runs, int initial_size, int size_increment);
+// Merges total_size elements split into k sorted runs for k = 2, 4, ..., max_ways, loser tree against a binary heap
+void RunKWayMergeBenchmarks(int total_size, int max_ways);
 void RunSearchingBenchmarks(int num_runs, int initial_size, int size_increment);
+// One run of sorts and searches on size elements, skipped unless the machine has the RAM for it
+void RunLargeBenchmarks(std::size_t size, unsigned int num_threads = 0);
+// Sorts on-disk datasets of memory_bytes * multiple bytes with external_sort and pipelined_external_sort,
+// throughput is recorded as mb_per_s and the busy fraction of each stage as <stage>_utilization
+void RunExternalSortBenchmarks(std::size_t memory_bytes, const std::vector<int>& dataset_multiples);
 void RunVisualizer(std::string filePath);
 void SaveProfilingData(const std::string& filePath);
\ No newline at end of file
@@ -1,11 +1,12 @@
 #include "searching.h"
+#include <algorithm>
 
 namespace searching {
-    void binary_search(int* arr, int size, int key) {
-        int left = 0;                      // O(1)
-        int right = size - 1;              // O(1)
+    void binary_search(int* arr, std::size_t size, int key) {
+        std::ptrdiff_t left = 0;                                        // O(1)
+        std::ptrdiff_t right = static_cast<std::ptrdiff_t>(size) - 1;   // O(1)
         while (left <= right) {            // O(log n) - loop runs log(n) times
-            int mid = left + (right - left) / 2;  // O(1)
+            std::ptrdiff_t mid = left + (right - left) / 2;  // O(1)
             if (arr[mid] == key) {         // O(1)
                 std::cout << "Element found at index " << mid << std::endl;  // O(1)
                 return;                    // O(1)
@@ -21,17 +22,21 @@ namespace searching {
     }
 
     // Implementation of Interpolation Search
-    int interpolation_once_binary_search(const int* arr, int size, int target) {
-		int left = 0, right = size - 1;                                                         // O(1)
+    std::ptrdiff_t interpolation_once_binary_search(const int* arr, std::size_t size, int target) {
+		std::ptrdiff_t left = 0, right = static_cast<std::ptrdiff_t>(size) - 1;                 // O(1)
 
 		while (left <= right && target >= arr[left] && target <= arr[right]) {                  // O(log n)
-			if (left == right) {                                                                // O(1)
+			if (left == right || arr[left] == arr[right]) {                                     // O(1) - also avoids dividing by zero
 				if (arr[left] == target) return left;                                           // O(1) 
                 return -1;
             }
 
-            // Probing position
-			int pos = left + ((target - arr[left]) * (right - left)) / (arr[right] - arr[left]); // O(1)
+            // Probing position. The value differences need 64 bits and their product with the index range
+            // can pass 2^63 past 2^31 elements, so the fraction of the range is computed in double instead
+			double fraction = static_cast<double>(static_cast<long long>(target) - arr[left])
+				/ static_cast<double>(static_cast<long long>(arr[right]) - arr[left]);                // O(1)
+			std::ptrdiff_t pos = left + static_cast<std::ptrdiff_t>(fraction * static_cast<double>(right - left)); // O(1)
+			pos = std::min(std::max(pos, left), right);                                         // O(1) - rounding can't leave the range
 
             // If found at pos
 			if (arr[pos] == target)                                                             // O(1)
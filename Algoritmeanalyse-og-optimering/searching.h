@@ -3,11 +3,12 @@
 #ifndef SEARCHING_H
 #define SEARCHING_H
 
+#include <cstddef>
 #include <iostream>
 
 namespace searching {
-    void binary_search(int* arr, int size, int key);
-	int interpolation_once_binary_search(const int* arr, int size, int target);
+    void binary_search(int* arr, std::size_t size, int key);
+	std::ptrdiff_t interpolation_once_binary_search(const int* arr, std::size_t size, int target);
 }
 
 
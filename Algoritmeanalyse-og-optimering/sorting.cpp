@@ -1,14 +1,35 @@
 #include "sorting.h"
+#include "sorting_generic.h"
+#include "sorting_simd.h"
+#include "ThreadPool.h"
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace sorting {
 
     // Insertion Sort implementation
-    void insertion_sort(std::vector<int>& arr, int left, int right) {
-        for (int i = left + 1; i <= right; ++i) {
+    void insertion_sort(std::vector<int>& arr, std::ptrdiff_t left, std::ptrdiff_t right) {
+        for (std::ptrdiff_t i = left + 1; i <= right; ++i) {
             int key = arr[i];
-            int j = i - 1;
+            std::ptrdiff_t j = i - 1;
             while (j >= left && arr[j] > key) {
                 arr[j + 1] = arr[j];
                 --j;
@@ -17,25 +38,40 @@ namespace sorting {
         }
     }
 
+    // Small range base case
+    int small_sort_cutoff = 32;     // Ranges up to this size go to the sorting network kernel, 0 disables it
+
+    void set_small_sort_cutoff(int cutoff) {
+        small_sort_cutoff = std::max(0, std::min(cutoff, SORTING_NETWORK_MAX));
+    }
+
     // Merge Sort implementation
-    void merge(std::vector<int>& arr, int left, int mid, int right) {
+    const int BITONIC_MERGE_CUTOFF = 64;    // Both runs need at least this many elements for the SIMD merge kernel
+
+    void merge(std::vector<int>& arr, std::ptrdiff_t left, std::ptrdiff_t mid, std::ptrdiff_t right) {
         // Step 1: Calculate sizes of the two subarrays
-        int n1 = mid - left + 1;   // O(1)
-        int n2 = right - mid;      // O(1)
+        std::ptrdiff_t n1 = mid - left + 1;   // O(1)
+        std::ptrdiff_t n2 = right - mid;      // O(1)
 
         // Step 2: Create temporary arrays
         std::vector<int> L(n1), R(n2);  // O(n) for allocation
 
         // Step 3: Copy data into the left subarray
-        for (int i = 0; i < n1; ++i)   // O(n1) or O(n)
-            L[i] = arr[left + i];      // O(1)
+        for (std::ptrdiff_t i = 0; i < n1; ++i)   // O(n1) or O(n)
+            L[i] = arr[left + i];                 // O(1)
 
         // Step 4: Copy data into the right subarray
-        for (int j = 0; j < n2; ++j)   // O(n2) or O(n)
-            R[j] = arr[mid + 1 + j];   // O(1)
+        for (std::ptrdiff_t j = 0; j < n2; ++j)   // O(n2) or O(n)
+            R[j] = arr[mid + 1 + j];              // O(1)
+
+        // Large runs are merged one SIMD register at a time instead of one element per branch
+        if (n1 >= BITONIC_MERGE_CUTOFF && n2 >= BITONIC_MERGE_CUTOFF) {
+            bitonic_merge(L.data(), n1, R.data(), n2, arr.data() + left);  // O(n)
+            return;
+        }
 
         // Step 5: Merge the two subarrays
-        int i = 0, j = 0, k = left;    // O(1)
+        std::ptrdiff_t i = 0, j = 0, k = left;   // O(1)
 
         while (i < n1 && j < n2) {      // O(n) - comparing and merging
             if (L[i] <= R[j]) {         // O(1)
@@ -64,10 +100,14 @@ namespace sorting {
         }
     }
 
-    void merge_sort(std::vector<int>& arr, int left, int right) {    
+    void merge_sort(std::vector<int>& arr, std::ptrdiff_t left, std::ptrdiff_t right) {    
+        if (right - left + 1 <= small_sort_cutoff) {   // O(1) - small ranges are sorted in registers
+            network_sort(arr.data() + left, static_cast<int>(right - left + 1));
+            return;
+        }
         if (left < right) {          // O(1) - base case check
             // Step 1: Calculate middle index
-            int mid = left + (right - left) / 2;  // O(1)
+            std::ptrdiff_t mid = left + (right - left) / 2;  // O(1)
 
             // Step 2: Recursively sort the left half
             merge_sort(arr, left, mid);          // O(log n) - recursive call
@@ -82,15 +122,956 @@ namespace sorting {
 
     // This is a wrapper function for simplicity
     void merge_sort(std::vector<int>& arr) {
-        merge_sort(arr, 0, arr.size() - 1);  // O(log n) recursive calls
+        merge_sort(arr, 0, static_cast<std::ptrdiff_t>(arr.size()) - 1);  // O(log n) recursive calls
+    }
+
+    // Buffered Merge Sort implementation
+    // Merges the sorted runs [a, a_end) and [b, b_end) into out without allocating
+    void merge_runs(const int* a, const int* a_end, const int* b, const int* b_end, int* out) {
+        while (a != a_end && b != b_end) {      // O(n) - comparing and merging
+            *out++ = (*b < *a) ? *b++ : *a++;   // O(1) - ties take from a, keeps it stable
+        }
+        while (a != a_end) *out++ = *a++;       // O(n1)
+        while (b != b_end) *out++ = *b++;       // O(n2)
+    }
+
+    // Merges src[left..mid] and src[mid+1..right] into dst[left..right]
+    void merge_into(const int* src, int* dst, std::ptrdiff_t left, std::ptrdiff_t mid, std::ptrdiff_t right) {
+        if (mid - left + 1 >= BITONIC_MERGE_CUTOFF && right - mid >= BITONIC_MERGE_CUTOFF) {
+            bitonic_merge(src + left, mid - left + 1, src + mid + 1, right - mid, dst + left);  // O(n)
+            return;
+        }
+        merge_runs(src + left, src + mid + 1, src + mid + 1, src + right + 1, dst + left);  // O(n)
+    }
+
+    // Sorts dst[left..right] using src as scratch. Both arrays must hold the same
+    // elements on entry; the roles swap on every level so no copy-back pass is needed.
+    void merge_sort_ping_pong(int* src, int* dst, std::ptrdiff_t left, std::ptrdiff_t right) {
+        if (right - left + 1 <= small_sort_cutoff) {         // O(1) - dst holds the same elements, sort it in registers
+            network_sort(dst + left, static_cast<int>(right - left + 1));
+            return;
+        }
+        if (left < right) {                                   // O(1) - base case check
+            std::ptrdiff_t mid = left + (right - left) / 2;   // O(1)
+
+            // Step 1: Sort both halves into src, using dst as scratch
+            merge_sort_ping_pong(dst, src, left, mid);       // O(log n)
+            merge_sort_ping_pong(dst, src, mid + 1, right);  // O(log n)
+
+            // Step 2: Merge the sorted halves from src back into dst
+            merge_into(src, dst, left, mid, right);          // O(n)
+        }
+    }
+
+    // Allocation-free wrapper: the buffer is grown once and can be reused across calls
+    void merge_sort(std::vector<int>& data, std::vector<int>& buffer) {
+        if (data.size() < 2) return;                         // O(1)
+
+        if (buffer.size() < data.size())                     // O(1)
+            buffer.resize(data.size());                      // O(n) - only when the buffer is too small
+        std::copy(data.begin(), data.end(), buffer.begin()); // O(n) - single copy up front
+
+        merge_sort_ping_pong(buffer.data(), data.data(), 0, static_cast<std::ptrdiff_t>(data.size()) - 1);
+    }
+
+
+    // In-Place Merge Sort implementation
+    const int IN_PLACE_RUN_LENGTH = 16;         // Runs of this length are insertion sorted before the first merge pass
+    const int IN_PLACE_MERGE_BUFFER = 256;      // Ints on the stack, a merge whose shorter run fits is done through them
+
+    // Stably merges a[lo..mid-1] and a[mid..hi-1] in place, buffer holds IN_PLACE_MERGE_BUFFER ints
+    void in_place_merge(int* a, std::ptrdiff_t lo, std::ptrdiff_t mid, std::ptrdiff_t hi, int* buffer) {
+        while (lo < mid && mid < hi && a[mid] < a[mid - 1]) {          // O(1) - stop once the runs are in order
+            const std::ptrdiff_t n1 = mid - lo;
+            const std::ptrdiff_t n2 = hi - mid;
+
+            // Short left run: move it out and merge forwards, ties take from the left run
+            if (n1 <= IN_PLACE_MERGE_BUFFER) {
+                std::copy(a + lo, a + mid, buffer);                     // O(n1)
+                merge_runs(buffer, buffer + n1, a + mid, a + hi, a + lo);  // O(n) - never overtakes the right run
+                return;
+            }
+
+            // Short right run: move it out and merge backwards, ties take from the right run
+            if (n2 <= IN_PLACE_MERGE_BUFFER) {
+                std::copy(a + mid, a + hi, buffer);                     // O(n2)
+                std::ptrdiff_t i = mid - 1, j = n2 - 1, k = hi - 1;
+                while (i >= lo && j >= 0)                               // O(n)
+                    a[k--] = (buffer[j] < a[i]) ? a[i--] : buffer[j--];
+                while (j >= 0)                                          // O(n2)
+                    a[k--] = buffer[j--];
+                return;
+            }
+
+            // Step 1: Split the longer run in half and find where its middle element goes in the other run
+            std::ptrdiff_t cut1, cut2;
+            if (n1 >= n2) {
+                cut1 = lo + n1 / 2;
+                cut2 = std::lower_bound(a + mid, a + hi, a[cut1]) - a;  // O(log n) - equal right elements stay behind it
+            }
+            else {
+                cut2 = mid + n2 / 2;
+                cut1 = std::upper_bound(a + lo, a + mid, a[cut2]) - a;  // O(log n) - equal left elements stay in front of it
+            }
+
+            // Step 2: Rotate the inner pieces past each other, every element of [lo, new_mid) now belongs before [new_mid, hi)
+            std::ptrdiff_t new_mid = std::rotate(a + cut1, a + mid, a + cut2) - a;  // O(n)
+
+            // Step 3: Recurse into the smaller side and loop on the larger one, keeping the stack O(log n)
+            if (new_mid - lo < hi - new_mid) {
+                in_place_merge(a, lo, cut1, new_mid, buffer);
+                lo = new_mid;
+                mid = cut2;
+            }
+            else {
+                in_place_merge(a, new_mid, cut2, hi, buffer);
+                hi = new_mid;
+                mid = cut1;
+            }
+        }
+    }
+
+    void in_place_merge_sort(std::vector<int>& data) {
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(data.size());
+        int* a = data.data();
+        int buffer[IN_PLACE_MERGE_BUFFER];                              // O(1) - the only scratch space
+
+        // Step 1: Insertion sort fixed-length runs, stable and allocation free
+        for (std::ptrdiff_t lo = 0; lo < n; lo += IN_PLACE_RUN_LENGTH) {
+            std::ptrdiff_t hi = std::min(lo + IN_PLACE_RUN_LENGTH, n);
+            for (std::ptrdiff_t i = lo + 1; i < hi; ++i) {              // O(RUN_LENGTH^2) per run
+                int key = a[i];
+                std::ptrdiff_t j = i - 1;
+                while (j >= lo && a[j] > key) {
+                    a[j + 1] = a[j];
+                    --j;
+                }
+                a[j + 1] = key;
+            }
+        }
+
+        // Step 2: Merge neighbouring runs bottom-up, doubling the run length every pass
+        for (std::ptrdiff_t width = IN_PLACE_RUN_LENGTH; width < n; width *= 2) {   // O(log n) passes
+            for (std::ptrdiff_t lo = 0; lo + width < n; lo += 2 * width)
+                in_place_merge(a, lo, lo + width, std::min(lo + 2 * width, n), buffer);  // O(n log n) per pass
+        }
+    }
+
+
+    // Parallel Merge Sort implementation
+    const int PARALLEL_SORT_CUTOFF = 1 << 14;   // Below this many elements a task sorts sequentially
+    const int PARALLEL_MERGE_CUTOFF = 1 << 16;  // Below this many elements a merge is not split
+
+    // Shared pool so repeated calls don't pay for thread creation, replaced when the thread count changes. Callers hold
+    // a reference for the whole sort, so a replaced pool lives on until its last sort finishes and is then destroyed;
+    // only one idle set of workers (blocked on a condition variable) stays around between calls.
+    std::shared_ptr<ThreadPool> get_thread_pool(unsigned int num_threads) {
+        static std::mutex pool_mutex;
+        static std::shared_ptr<ThreadPool> pool;
+
+        if (num_threads == 0)
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (!pool || pool->Size() != num_threads)
+            pool = std::make_shared<ThreadPool>(num_threads);
+        return pool;
+    }
+
+    // Co-rank (merge path) search: how many of the first k outputs of a stable merge of
+    // a[0..n1) and b[0..n2) come from a. O(log n) binary search along the merge path diagonal.
+    std::ptrdiff_t co_rank(std::ptrdiff_t k, const int* a, std::ptrdiff_t n1, const int* b, std::ptrdiff_t n2) {
+        std::ptrdiff_t lo = std::max<std::ptrdiff_t>(0, k - n2);   // O(1)
+        std::ptrdiff_t hi = std::min(k, n1);                       // O(1)
+        while (lo < hi) {                                          // O(log n)
+            std::ptrdiff_t i = lo + (hi - lo) / 2;                 // O(1) - candidate count taken from a
+            std::ptrdiff_t j = k - i;                              // O(1) - the rest comes from b
+            if (a[i] <= b[j - 1])                                  // O(1) - a[i] precedes b[j-1], so more of a is needed
+                lo = i + 1;
+            else
+                hi = i;
+        }
+        return lo;
+    }
+
+    // Merges src[left..mid] and src[mid+1..right] into dst[left..right], splitting the output into
+    // independent chunks with co_rank so large merges use every thread
+    void parallel_merge_into(ThreadPool& pool, const int* src, int* dst, std::ptrdiff_t left, std::ptrdiff_t mid, std::ptrdiff_t right) {
+        const std::ptrdiff_t n1 = mid - left + 1;
+        const std::ptrdiff_t n2 = right - mid;
+        const std::ptrdiff_t n = n1 + n2;
+        const int chunks = static_cast<int>(std::min<std::ptrdiff_t>(pool.Size() * 4, n / (PARALLEL_MERGE_CUTOFF / 4)));
+
+        if (chunks < 2) {
+            merge_into(src, dst, left, mid, right);
+            return;
+        }
+
+        const int* a = src + left;
+        const int* b = src + mid + 1;
+        TaskGroup group(pool);
+        for (int c = 0; c < chunks; ++c) {
+            group.Run([=] {
+                // Output range [k0, k1) of this chunk and the matching input ranges
+                std::ptrdiff_t k0 = n * c / chunks;
+                std::ptrdiff_t k1 = n * (c + 1) / chunks;
+                std::ptrdiff_t i0 = co_rank(k0, a, n1, b, n2);
+                std::ptrdiff_t i1 = co_rank(k1, a, n1, b, n2);
+                merge_runs(a + i0, a + i1, b + (k0 - i0), b + (k1 - i1), dst + left + k0);
+            });
+        }
+        group.Wait();
+    }
+
+    // Same ping-pong scheme as merge_sort_ping_pong, with the left half forked as a task
+    void parallel_merge_sort_ping_pong(ThreadPool& pool, int* src, int* dst, std::ptrdiff_t left, std::ptrdiff_t right) {
+        if (right - left + 1 <= PARALLEL_SORT_CUTOFF) {
+            merge_sort_ping_pong(src, dst, left, right);
+            return;
+        }
+
+        std::ptrdiff_t mid = left + (right - left) / 2;
+        {
+            TaskGroup group(pool);
+            group.Run([&] { parallel_merge_sort_ping_pong(pool, dst, src, left, mid); });
+            parallel_merge_sort_ping_pong(pool, dst, src, mid + 1, right);
+            group.Wait();
+        }
+        parallel_merge_into(pool, src, dst, left, mid, right);
+    }
+
+    void parallel_merge_sort(std::vector<int>& data, unsigned int num_threads) {
+        if (data.size() < 2) return;
+
+        std::shared_ptr<ThreadPool> shared_pool = get_thread_pool(num_threads);  // Keeps the pool alive for this call
+        ThreadPool& pool = *shared_pool;
+        std::vector<int> buffer(data);          // O(n) - one scratch copy for the whole sort
+        parallel_merge_sort_ping_pong(pool, buffer.data(), data.data(), 0, static_cast<std::ptrdiff_t>(data.size()) - 1);
+    }
+
+
+    // K-Way Merge implementation (tournament tree of losers, Knuth TAOCP vol. 3, 5.4.1)
+    const std::uint64_t LOSER_TREE_EXHAUSTED = ~std::uint64_t(0);  // Key of a run with nothing left, loses to every element
+
+    // One match of the tournament: the losing run and its current head, cached so a replay needs no extra load
+    struct LoserTreeNode {
+        std::uint64_t key;
+        std::int32_t run;
+    };
+
+    // Maps an int to an unsigned key with the same order, leaving room above it for LOSER_TREE_EXHAUSTED
+    inline std::uint64_t loser_tree_key(int value) {
+        return static_cast<std::uint32_t>(value) ^ 0x80000000u;
+    }
+
+    void kway_merge(const std::vector<SortedRun>& runs, int* out) {
+        const std::ptrdiff_t k = static_cast<std::ptrdiff_t>(runs.size());
+        if (k == 0) return;
+        if (k == 1) {
+            std::copy(runs[0].data, runs[0].data + runs[0].size, out);       // O(n)
+            return;
+        }
+
+        // Step 1: Pad k up to a power of two, the padding leaves start out exhausted
+        std::ptrdiff_t leaves = 1;
+        while (leaves < k) leaves <<= 1;                                      // O(log k)
+
+        std::vector<const int*> heads(leaves, nullptr);
+        std::vector<const int*> ends(leaves, nullptr);
+        std::vector<LoserTreeNode> winners(2 * leaves);                       // Only needed while building
+        std::ptrdiff_t total = 0;
+        for (std::ptrdiff_t i = 0; i < leaves; ++i) {
+            winners[leaves + i] = { LOSER_TREE_EXHAUSTED, static_cast<std::int32_t>(i) };
+            if (i < k) {
+                heads[i] = runs[i].data;
+                ends[i] = runs[i].data + runs[i].size;
+                if (runs[i].size > 0)
+                    winners[leaves + i].key = loser_tree_key(runs[i].data[0]);
+                total += runs[i].size;
+            }
+        }
+
+        // Step 2: Play the initial tournament bottom up, tree[1..leaves-1] keeps the loser of every match
+        std::vector<LoserTreeNode> tree(leaves);
+        for (std::ptrdiff_t node = leaves - 1; node >= 1; --node) {            // O(k)
+            const LoserTreeNode& a = winners[2 * node];
+            const LoserTreeNode& b = winners[2 * node + 1];
+            bool a_wins = a.key <= b.key;
+            winners[node] = a_wins ? a : b;
+            tree[node] = a_wins ? b : a;
+        }
+        LoserTreeNode winner = winners[1];
+
+        // Step 3: Emit the winner, advance its run and replay only the matches on its leaf-to-root path
+        for (std::ptrdiff_t o = 0; o < total; ++o) {                          // O(n log k)
+            const std::int32_t run = winner.run;
+            out[o] = *heads[run]++;
+            winner.key = heads[run] != ends[run] ? loser_tree_key(*heads[run]) : LOSER_TREE_EXHAUSTED;
+
+            for (std::ptrdiff_t node = (leaves + run) >> 1; node >= 1; node >>= 1) {  // O(log k)
+                LoserTreeNode loser = tree[node];
+                bool loser_wins = loser.key < winner.key;                     // O(1) - selects below compile to cmov, no mispredicts
+                tree[node] = loser_wins ? winner : loser;
+                winner = loser_wins ? loser : winner;
+            }
+        }
+    }
+
+
+    // Cache-Blocked Merge Sort implementation
+    const std::size_t DEFAULT_L2_CACHE_BYTES = std::size_t(256) << 10;   // Used when the L2 size can't be queried
+    const std::ptrdiff_t CACHE_BLOCKED_MIN_PIECE = 1024;                // A merge pass takes at least this many elements per run and tile
+
+    const CacheSizes& detect_cache_sizes() {
+        static const CacheSizes sizes = [] {
+            CacheSizes result = { 0, 0, 0 };
+#if defined(_WIN32)
+            DWORD length = 0;
+            GetLogicalProcessorInformation(nullptr, &length);
+            std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+            if (!info.empty() && GetLogicalProcessorInformation(info.data(), &length)) {
+                for (const auto& entry : info) {
+                    if (entry.Relationship != RelationCache || entry.Cache.Type == CacheInstruction)
+                        continue;
+                    std::size_t bytes = entry.Cache.Size;
+                    if (entry.Cache.Level == 1) result.l1 = std::max(result.l1, bytes);
+                    if (entry.Cache.Level == 2) result.l2 = std::max(result.l2, bytes);
+                    if (entry.Cache.Level == 3) result.l3 = std::max(result.l3, bytes);
+                }
+            }
+#elif defined(_SC_LEVEL2_CACHE_SIZE)
+            result.l1 = static_cast<std::size_t>(std::max(0L, sysconf(_SC_LEVEL1_DCACHE_SIZE)));
+            result.l2 = static_cast<std::size_t>(std::max(0L, sysconf(_SC_LEVEL2_CACHE_SIZE)));
+            result.l3 = static_cast<std::size_t>(std::max(0L, sysconf(_SC_LEVEL3_CACHE_SIZE)));
+#endif
+            return result;
+        }();
+        return sizes;
+    }
+
+    // Multi-sequence selection: splits[i] elements of runs[i] make up the r smallest elements of all runs, ties are
+    // taken from earlier runs first so merging the pieces keeps the sort stable. O(32 k log n) binary searches.
+    void select_rank(const std::vector<SortedRun>& runs, std::ptrdiff_t r, std::vector<std::ptrdiff_t>& splits) {
+        // Step 1: Find the smallest value v with at least r elements <= v
+        std::int64_t lo = INT_MIN, hi = INT_MAX;
+        while (lo < hi) {                                                       // O(32) iterations
+            std::int64_t v = lo + (hi - lo) / 2;
+            std::ptrdiff_t count = 0;
+            for (const SortedRun& run : runs)                                   // O(k log n)
+                count += std::upper_bound(run.data, run.data + run.size, static_cast<int>(v)) - run.data;
+            if (count >= r)
+                hi = v;
+            else
+                lo = v + 1;
+        }
+
+        // Step 2: Take everything below v, then fill up with copies of v from the earliest runs
+        std::ptrdiff_t remaining = r;
+        for (std::size_t i = 0; i < runs.size(); ++i) {
+            splits[i] = std::lower_bound(runs[i].data, runs[i].data + runs[i].size, static_cast<int>(lo)) - runs[i].data;
+            remaining -= splits[i];
+        }
+        for (std::size_t i = 0; i < runs.size() && remaining > 0; ++i) {
+            std::ptrdiff_t equal = std::upper_bound(runs[i].data + splits[i], runs[i].data + runs[i].size, static_cast<int>(lo)) - (runs[i].data + splits[i]);
+            std::ptrdiff_t take = std::min(remaining, equal);
+            splits[i] += take;
+            remaining -= take;
+        }
+    }
+
+    // Merges the pieces of one output tile pairwise, level by level, ping-ponging between the two cache-resident halves
+    // of tile. Only the first level reads memory and only the last writes it, to out.
+    void merge_tile(std::vector<SortedRun>& pieces, std::vector<SortedRun>& next, int* tile, std::ptrdiff_t tile_size, int* out) {
+        int* target = tile;
+        for (;;) {                                                              // O(log k) levels
+            int* dst = pieces.size() <= 2 ? out : target;                     // The last level writes the output
+            int* write = dst;
+            next.clear();
+            for (std::size_t i = 0; i < pieces.size(); i += 2) {
+                const SortedRun& a = pieces[i];
+                SortedRun b = i + 1 < pieces.size() ? pieces[i + 1] : SortedRun{ nullptr, 0 };
+                if (a.size >= BITONIC_MERGE_CUTOFF && b.size >= BITONIC_MERGE_CUTOFF)
+                    bitonic_merge(a.data, a.size, b.data, b.size, write);      // O(n) - the runs sit in L2
+                else
+                    merge_runs(a.data, a.data + a.size, b.data, b.data + b.size, write);
+                next.push_back({ write, a.size + b.size });
+                write += a.size + b.size;
+            }
+            pieces.swap(next);
+            if (dst == out) return;
+            target = target == tile ? tile + tile_size : tile;                 // O(1) - swap tile halves
+        }
+    }
+
+    void cache_blocked_merge_sort(std::vector<int>& data, std::size_t block_elements) {
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(data.size());
+        if (n < 2) return;
+
+        // Step 1: A block and its scratch half together fill the L2 cache, so do the two halves of a merge tile
+        if (block_elements == 0) {
+            std::size_t l2 = detect_cache_sizes().l2;
+            block_elements = (l2 != 0 ? l2 : DEFAULT_L2_CACHE_BYTES) / (2 * sizeof(int));
+        }
+        const std::ptrdiff_t block = std::max<std::ptrdiff_t>(2 * CACHE_BLOCKED_MIN_PIECE, static_cast<std::ptrdiff_t>(block_elements));
+        const std::ptrdiff_t blocks = (n + block - 1) / block;
+
+        // Step 2: Every run must still contribute a useful piece to a tile, which caps the fan-in of one pass.
+        // Pick the fewest passes that cap allows and the smallest fan-in that still needs only that many.
+        const std::ptrdiff_t max_fan_in = std::max<std::ptrdiff_t>(2, block / CACHE_BLOCKED_MIN_PIECE);
+        int passes = 0;
+        for (std::ptrdiff_t reach = 1; reach < blocks; reach *= max_fan_in)
+            ++passes;
+        std::ptrdiff_t fan_in = 2;
+        for (;;) {
+            std::ptrdiff_t reach = 1;
+            for (int p = 0; p < passes; ++p) reach *= fan_in;
+            if (reach >= blocks) break;
+            ++fan_in;
+        }
+
+        // Step 3: Sort every block in cache, into the buffer when an odd number of passes will bring it back to data
+        std::vector<int> buffer(n);
+        int* sorted = passes % 2 == 0 ? data.data() : buffer.data();
+        int* scratch = passes % 2 == 0 ? buffer.data() : data.data();
+        for (std::ptrdiff_t lo = 0; lo < n; lo += block) {                        // O(n log block)
+            std::ptrdiff_t hi = std::min(lo + block, n) - 1;
+            std::copy(data.begin() + lo, data.begin() + hi + 1, buffer.begin() + lo);  // O(block) - both arrays now hold the block
+            merge_sort_ping_pong(scratch, sorted, lo, hi);                      // O(block log block) - stays in L2
+        }
+
+        // Step 4: Every pass merges groups of fan_in neighbouring runs into runs fan_in times longer. The output of a
+        // group is cut into block-sized tiles with select_rank and every tile is merged in cache, so a pass reads and
+        // writes memory once instead of log2(fan_in) times.
+        std::vector<int> tile(2 * block);
+        std::vector<SortedRun> runs, pieces, next;
+        std::vector<std::ptrdiff_t> begin_splits, end_splits;
+        for (std::ptrdiff_t run = block; run < n; run *= fan_in) {              // O(passes) - one or two for in-memory sizes
+            for (std::ptrdiff_t lo = 0; lo < n; lo += run * fan_in) {
+                runs.clear();
+                for (std::ptrdiff_t r = lo; r < std::min(lo + run * fan_in, n); r += run)
+                    runs.push_back({ sorted + r, std::min(run, n - r) });
+                const std::ptrdiff_t group = std::min(run * fan_in, n - lo);
+
+                begin_splits.assign(runs.size(), 0);
+                end_splits.resize(runs.size());
+                for (std::ptrdiff_t t = 0; t < group; t += block) {             // O(group / block) tiles
+                    const std::ptrdiff_t t_end = std::min(t + block, group);
+                    if (t_end == group) {
+                        for (std::size_t i = 0; i < runs.size(); ++i) end_splits[i] = runs[i].size;
+                    }
+                    else {
+                        select_rank(runs, t_end, end_splits);
+                    }
+
+                    pieces.clear();
+                    for (std::size_t i = 0; i < runs.size(); ++i) {
+                        if (end_splits[i] > begin_splits[i])
+                            pieces.push_back({ runs[i].data + begin_splits[i], end_splits[i] - begin_splits[i] });
+                    }
+                    merge_tile(pieces, next, tile.data(), block, scratch + lo + t);  // O(block log fan_in) in cache
+                    begin_splits.swap(end_splits);
+                }
+            }
+            std::swap(sorted, scratch);
+        }
     }
 
+    // Tim Sort implementation (Tim Peters 2002, run stack invariants as fixed by de Gouw et al. 2015)
+    const int TIM_SORT_MIN_MERGE = 32;      // Arrays smaller than this are binary insertion sorted in one go
+    const int TIM_SORT_MIN_GALLOP = 7;      // Wins in a row before a merge switches to galloping
+    const int TIM_SORT_MAX_RUNS = 85;       // Run lengths grow like Fibonacci numbers, 85 covers any 64-bit length
+
+    struct TimSortState {
+        int* a;
+        std::vector<int> tmp;               // Holds the smaller of the two runs during a merge
+        int min_gallop = TIM_SORT_MIN_GALLOP;
+        std::ptrdiff_t run_base[TIM_SORT_MAX_RUNS];
+        std::ptrdiff_t run_len[TIM_SORT_MAX_RUNS];
+        int stack_size = 0;
+    };
+
+    // Minimum run length: n / 2^k in [MIN_MERGE / 2, MIN_MERGE], rounded up if any shifted-out bit was set,
+    // so n / min_run is a power of two or slightly less and the final merges stay balanced
+    std::ptrdiff_t tim_sort_min_run(std::ptrdiff_t n) {
+        std::ptrdiff_t r = 0;
+        while (n >= TIM_SORT_MIN_MERGE) {                               // O(log n)
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    // Returns the length of the run starting at a[lo] (hi exclusive), strictly descending runs are reversed
+    // in place. Strict descent keeps equal keys in order, so the sort stays stable.
+    std::ptrdiff_t count_run_and_make_ascending(int* a, std::ptrdiff_t lo, std::ptrdiff_t hi) {
+        std::ptrdiff_t run_hi = lo + 1;
+        if (run_hi == hi) return 1;
+
+        if (a[run_hi++] < a[lo]) {
+            while (run_hi < hi && a[run_hi] < a[run_hi - 1]) ++run_hi;    // O(run)
+            std::reverse(a + lo, a + run_hi);                           // O(run)
+        }
+        else {
+            while (run_hi < hi && !(a[run_hi] < a[run_hi - 1])) ++run_hi; // O(run)
+        }
+        return run_hi - lo;
+    }
+
+    // Sorts a[lo..hi) where a[lo..start) is already sorted, binary search keeps comparisons at O(log k)
+    void binary_insertion_sort(int* a, std::ptrdiff_t lo, std::ptrdiff_t hi, std::ptrdiff_t start) {
+        if (start == lo) ++start;
+        for (; start < hi; ++start) {                                   // O(k^2) moves, O(k log k) compares
+            int pivot = a[start];
+            std::ptrdiff_t left = lo, right = start;
+            while (left < right) {                                      // Rightmost position keeps it stable
+                std::ptrdiff_t mid = left + (right - left) / 2;
+                if (pivot < a[mid]) right = mid;
+                else left = mid + 1;
+            }
+            std::copy_backward(a + left, a + start, a + start + 1);
+            a[left] = pivot;
+        }
+    }
+
+    // Position of key in the sorted a[0..len) just before any equal elements. Starts at hint and gallops
+    // outwards in steps of 1, 3, 7, ... before a binary search, so it costs O(log d) for distance d.
+    std::ptrdiff_t gallop_left(int key, const int* a, std::ptrdiff_t len, std::ptrdiff_t hint) {
+        std::ptrdiff_t last_ofs = 0, ofs = 1;
+        if (a[hint] < key) {
+            // Gallop right until a[hint + last_ofs] < key <= a[hint + ofs]
+            std::ptrdiff_t max_ofs = len - hint;
+            while (ofs < max_ofs && a[hint + ofs] < key) {
+                last_ofs = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) ofs = max_ofs;                            // Overflow
+            }
+            if (ofs > max_ofs) ofs = max_ofs;
+            last_ofs += hint;
+            ofs += hint;
+        }
+        else {
+            // Gallop left until a[hint - ofs] < key <= a[hint - last_ofs]
+            std::ptrdiff_t max_ofs = hint + 1;
+            while (ofs < max_ofs && !(a[hint - ofs] < key)) {
+                last_ofs = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) ofs = max_ofs;
+            }
+            if (ofs > max_ofs) ofs = max_ofs;
+            std::ptrdiff_t t = last_ofs;
+            last_ofs = hint - ofs;
+            ofs = hint - t;
+        }
+
+        // Binary search in a[last_ofs + 1 .. ofs]
+        ++last_ofs;
+        while (last_ofs < ofs) {
+            std::ptrdiff_t m = last_ofs + ((ofs - last_ofs) >> 1);
+            if (a[m] < key) last_ofs = m + 1;
+            else ofs = m;
+        }
+        return ofs;
+    }
+
+    // Like gallop_left, but returns the position just after any elements equal to key
+    std::ptrdiff_t gallop_right(int key, const int* a, std::ptrdiff_t len, std::ptrdiff_t hint) {
+        std::ptrdiff_t last_ofs = 0, ofs = 1;
+        if (key < a[hint]) {
+            // Gallop left until a[hint - ofs] <= key < a[hint - last_ofs]
+            std::ptrdiff_t max_ofs = hint + 1;
+            while (ofs < max_ofs && key < a[hint - ofs]) {
+                last_ofs = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) ofs = max_ofs;
+            }
+            if (ofs > max_ofs) ofs = max_ofs;
+            std::ptrdiff_t t = last_ofs;
+            last_ofs = hint - ofs;
+            ofs = hint - t;
+        }
+        else {
+            // Gallop right until a[hint + last_ofs] <= key < a[hint + ofs]
+            std::ptrdiff_t max_ofs = len - hint;
+            while (ofs < max_ofs && !(key < a[hint + ofs])) {
+                last_ofs = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) ofs = max_ofs;
+            }
+            if (ofs > max_ofs) ofs = max_ofs;
+            last_ofs += hint;
+            ofs += hint;
+        }
+
+        ++last_ofs;
+        while (last_ofs < ofs) {
+            std::ptrdiff_t m = last_ofs + ((ofs - last_ofs) >> 1);
+            if (key < a[m]) ofs = m;
+            else last_ofs = m + 1;
+        }
+        return ofs;
+    }
+
+    // Merges the adjacent runs a[base1..base1+len1) and a[base2..base2+len2) with len1 <= len2, from the left.
+    // Run 1 is copied out; once one side wins TIM_SORT_MIN_GALLOP times in a row the merge gallops,
+    // copying whole blocks found with gallop_left/right instead of comparing element by element.
+    void tim_sort_merge_lo(TimSortState& state, std::ptrdiff_t base1, std::ptrdiff_t len1, std::ptrdiff_t base2, std::ptrdiff_t len2) {
+        int* a = state.a;
+        int* tmp = state.tmp.data();
+        std::copy(a + base1, a + base1 + len1, tmp);                    // O(len1)
+
+        std::ptrdiff_t cursor1 = 0;                                     // Into tmp
+        std::ptrdiff_t cursor2 = base2;                                 // Into a
+        std::ptrdiff_t dest = base1;
+
+        // The first element of run 2 is known to come first (merge_at trimmed run 1)
+        a[dest++] = a[cursor2++];
+        if (--len2 == 0) {
+            std::copy(tmp + cursor1, tmp + cursor1 + len1, a + dest);
+            return;
+        }
+        if (len1 == 1) {
+            std::copy(a + cursor2, a + cursor2 + len2, a + dest);
+            a[dest + len2] = tmp[cursor1];                              // Last element of run 1 goes last
+            return;
+        }
+
+        int min_gallop = state.min_gallop;
+        bool done = false;
+        while (!done) {
+            std::ptrdiff_t count1 = 0, count2 = 0;                      // Wins in a row of each run
+
+            // Step 1: One element at a time until one run starts winning consistently
+            while (true) {
+                if (a[cursor2] < tmp[cursor1]) {
+                    a[dest++] = a[cursor2++];
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 0) { done = true; break; }
+                }
+                else {
+                    a[dest++] = tmp[cursor1++];
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 1) { done = true; break; }
+                }
+                if ((count1 | count2) >= min_gallop) break;
+            }
+            if (done) break;
+
+            // Step 2: Gallop while it keeps paying off, then make galloping easier to re-enter
+            do {
+                count1 = gallop_right(a[cursor2], tmp + cursor1, len1, 0);
+                if (count1 != 0) {
+                    std::copy(tmp + cursor1, tmp + cursor1 + count1, a + dest);
+                    dest += count1;
+                    cursor1 += count1;
+                    len1 -= count1;
+                    if (len1 <= 1) { done = true; break; }
+                }
+                a[dest++] = a[cursor2++];
+                if (--len2 == 0) { done = true; break; }
+
+                count2 = gallop_left(tmp[cursor1], a + cursor2, len2, 0);
+                if (count2 != 0) {
+                    std::copy(a + cursor2, a + cursor2 + count2, a + dest);  // dest < cursor2, forward copy is safe
+                    dest += count2;
+                    cursor2 += count2;
+                    len2 -= count2;
+                    if (len2 == 0) { done = true; break; }
+                }
+                a[dest++] = tmp[cursor1++];
+                if (--len1 == 1) { done = true; break; }
+                --min_gallop;
+            } while (count1 >= TIM_SORT_MIN_GALLOP || count2 >= TIM_SORT_MIN_GALLOP);
+            if (done) break;
+
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2;                                            // Penalty for leaving gallop mode
+        }
+        state.min_gallop = min_gallop < 1 ? 1 : min_gallop;
+
+        // Step 3: Copy whatever is left
+        if (len1 == 1) {
+            std::copy(a + cursor2, a + cursor2 + len2, a + dest);
+            a[dest + len2] = tmp[cursor1];
+        }
+        else {
+            std::copy(tmp + cursor1, tmp + cursor1 + len1, a + dest);   // len2 == 0
+        }
+    }
+
+    // Mirror image of tim_sort_merge_lo for len1 > len2: run 2 is copied out and the merge runs from the right
+    void tim_sort_merge_hi(TimSortState& state, std::ptrdiff_t base1, std::ptrdiff_t len1, std::ptrdiff_t base2, std::ptrdiff_t len2) {
+        int* a = state.a;
+        int* tmp = state.tmp.data();
+        std::copy(a + base2, a + base2 + len2, tmp);                    // O(len2)
+
+        std::ptrdiff_t cursor1 = base1 + len1 - 1;                      // Into a
+        std::ptrdiff_t cursor2 = len2 - 1;                              // Into tmp
+        std::ptrdiff_t dest = base2 + len2 - 1;
+
+        // The last element of run 1 is known to come last (merge_at trimmed run 2)
+        a[dest--] = a[cursor1--];
+        if (--len1 == 0) {
+            std::copy(tmp, tmp + len2, a + dest - (len2 - 1));
+            return;
+        }
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            std::copy_backward(a + cursor1 + 1, a + cursor1 + 1 + len1, a + dest + 1 + len1);
+            a[dest] = tmp[cursor2];                                     // First element of run 2 goes first
+            return;
+        }
+
+        int min_gallop = state.min_gallop;
+        bool done = false;
+        while (!done) {
+            std::ptrdiff_t count1 = 0, count2 = 0;
+
+            // Step 1: One element at a time until one run starts winning consistently
+            while (true) {
+                if (tmp[cursor2] < a[cursor1]) {
+                    a[dest--] = a[cursor1--];
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 0) { done = true; break; }
+                }
+                else {
+                    a[dest--] = tmp[cursor2--];
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 1) { done = true; break; }
+                }
+                if ((count1 | count2) >= min_gallop) break;
+            }
+            if (done) break;
+
+            // Step 2: Gallop while it keeps paying off
+            do {
+                count1 = len1 - gallop_right(tmp[cursor2], a + base1, len1, len1 - 1);
+                if (count1 != 0) {
+                    dest -= count1;
+                    cursor1 -= count1;
+                    len1 -= count1;
+                    std::copy_backward(a + cursor1 + 1, a + cursor1 + 1 + count1, a + dest + 1 + count1);
+                    if (len1 == 0) { done = true; break; }
+                }
+                a[dest--] = tmp[cursor2--];
+                if (--len2 == 1) { done = true; break; }
+
+                count2 = len2 - gallop_left(a[cursor1], tmp, len2, len2 - 1);
+                if (count2 != 0) {
+                    dest -= count2;
+                    cursor2 -= count2;
+                    len2 -= count2;
+                    std::copy(tmp + cursor2 + 1, tmp + cursor2 + 1 + count2, a + dest + 1);
+                    if (len2 <= 1) { done = true; break; }
+                }
+                a[dest--] = a[cursor1--];
+                if (--len1 == 0) { done = true; break; }
+                --min_gallop;
+            } while (count1 >= TIM_SORT_MIN_GALLOP || count2 >= TIM_SORT_MIN_GALLOP);
+            if (done) break;
+
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2;
+        }
+        state.min_gallop = min_gallop < 1 ? 1 : min_gallop;
+
+        // Step 3: Copy whatever is left
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            std::copy_backward(a + cursor1 + 1, a + cursor1 + 1 + len1, a + dest + 1 + len1);
+            a[dest] = tmp[cursor2];
+        }
+        else {
+            std::copy(tmp, tmp + len2, a + dest - (len2 - 1));          // len1 == 0
+        }
+    }
+
+    // Merges the runs at stack positions i and i + 1
+    void tim_sort_merge_at(TimSortState& state, int i) {
+        std::ptrdiff_t base1 = state.run_base[i], len1 = state.run_len[i];
+        std::ptrdiff_t base2 = state.run_base[i + 1], len2 = state.run_len[i + 1];
+
+        // Step 1: Record the merged run and drop run i + 1 from the stack
+        state.run_len[i] = len1 + len2;
+        if (i == state.stack_size - 3) {
+            state.run_base[i + 1] = state.run_base[i + 2];
+            state.run_len[i + 1] = state.run_len[i + 2];
+        }
+        --state.stack_size;
+
+        // Step 2: Elements of run 1 before the first element of run 2 are already in place
+        std::ptrdiff_t k = gallop_right(state.a[base2], state.a + base1, len1, 0);   // O(log n)
+        base1 += k;
+        len1 -= k;
+        if (len1 == 0) return;
+
+        // Step 3: So are the elements of run 2 after the last element of run 1
+        len2 = gallop_left(state.a[base1 + len1 - 1], state.a + base2, len2, len2 - 1);
+        if (len2 == 0) return;
+
+        // Step 4: Merge the rest, copying out the shorter run
+        if (len1 <= len2) tim_sort_merge_lo(state, base1, len1, base2, len2);
+        else tim_sort_merge_hi(state, base1, len1, base2, len2);
+    }
+
+    // Merges runs until the stack invariants hold again: len[i-2] > len[i-1] + len[i] and len[i-1] > len[i]
+    void tim_sort_merge_collapse(TimSortState& state) {
+        const std::ptrdiff_t* len = state.run_len;
+        while (state.stack_size > 1) {
+            int n = state.stack_size - 2;
+            if ((n > 0 && len[n - 1] <= len[n] + len[n + 1]) || (n > 1 && len[n - 2] <= len[n - 1] + len[n])) {
+                if (len[n - 1] < len[n + 1]) --n;
+            }
+            else if (len[n] > len[n + 1]) {
+                break;
+            }
+            tim_sort_merge_at(state, n);
+        }
+    }
+
+    void tim_sort(std::vector<int>& data) {
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(data.size());
+        if (n < 2) return;                                              // O(1)
+
+        // Step 1: Small arrays are one run extended with binary insertion
+        if (n < TIM_SORT_MIN_MERGE) {
+            std::ptrdiff_t run_len = count_run_and_make_ascending(data.data(), 0, n);
+            binary_insertion_sort(data.data(), 0, n, run_len);          // O(n^2) for n < 32
+            return;
+        }
+
+        TimSortState state;
+        state.a = data.data();
+        state.tmp.resize(n / 2);                                        // Merges copy out the shorter run only
+
+        // Step 2: Find natural runs, extend short ones to min_run, and keep the run stack balanced
+        const std::ptrdiff_t min_run = tim_sort_min_run(n);
+        std::ptrdiff_t lo = 0;
+        while (lo < n) {                                                // O(n) when the input is one run
+            std::ptrdiff_t run_len = count_run_and_make_ascending(state.a, lo, n);
+            if (run_len < min_run) {
+                std::ptrdiff_t forced = std::min(n - lo, min_run);
+                binary_insertion_sort(state.a, lo, lo + forced, lo + run_len);
+                run_len = forced;
+            }
+
+            state.run_base[state.stack_size] = lo;
+            state.run_len[state.stack_size] = run_len;
+            ++state.stack_size;
+            tim_sort_merge_collapse(state);
+            lo += run_len;
+        }
+
+        // Step 3: Merge the remaining runs, always the smaller neighbour first
+        while (state.stack_size > 1) {
+            int i = state.stack_size - 2;
+            if (i > 0 && state.run_len[i - 1] < state.run_len[i + 1]) --i;
+            tim_sort_merge_at(state, i);
+        }
+    }
+
+
+    // Random pivot generator
+    // PCG32 (O'Neill 2014): 16 bytes of state and a multiply-add per number, instead of constructing
+    // std::random_device and a 2.5 KB std::mt19937 on every partition call
+    struct Pcg32 {
+        std::uint64_t state = 0;
+        std::uint64_t increment = 1;
+
+        void seed(std::uint64_t seed_value, std::uint64_t stream) {
+            state = 0;
+            increment = (stream << 1u) | 1u;                            // Must be odd
+            next();
+            state += seed_value;
+            next();
+        }
+
+        std::uint32_t next() {
+            std::uint64_t old_state = state;
+            state = old_state * 6364136223846793005ULL + increment;     // LCG step
+            std::uint32_t xorshifted = static_cast<std::uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+            std::uint32_t rotation = static_cast<std::uint32_t>(old_state >> 59u);
+            return (xorshifted >> rotation) | (xorshifted << ((32u - rotation) & 31u));  // Random rotation
+        }
+    };
+
+    std::atomic<std::uint64_t> random_pivot_seed(0);
+    std::atomic<unsigned int> random_pivot_seed_generation(0);        // 0 = no explicit seed, bumped on every set
+
+    void set_random_pivot_seed(std::uint64_t seed) {
+        random_pivot_seed.store(seed, std::memory_order_relaxed);
+        random_pivot_seed_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // Uniform index in [low, high] from the calling thread's generator, seeded once per thread
+    // (or again after set_random_pivot_seed)
+    std::ptrdiff_t random_index(std::ptrdiff_t low, std::ptrdiff_t high) {
+        thread_local Pcg32 generator;
+        thread_local bool seeded = false;
+        thread_local unsigned int seen_generation = 0;
+
+        unsigned int generation = random_pivot_seed_generation.load(std::memory_order_acquire);
+        if (!seeded || generation != seen_generation) {
+            if (generation == 0) {
+                std::random_device rd;
+                generator.seed((static_cast<std::uint64_t>(rd()) << 32) | rd(), rd());
+            }
+            else {
+                generator.seed(random_pivot_seed.load(std::memory_order_relaxed), 0);
+            }
+            seeded = true;
+            seen_generation = generation;
+        }
+
+        // Lemire's multiply-shift maps a 32-bit number onto the range without a division
+        std::uint64_t range = static_cast<std::uint64_t>(high - low) + 1;
+        if (range <= (1ULL << 32))
+            return low + static_cast<std::ptrdiff_t>((generator.next() * range) >> 32);
+
+        // Ranges past 2^32 elements need 64 random bits, the modulo bias is below 2^-31 there
+        std::uint64_t bits = (static_cast<std::uint64_t>(generator.next()) << 32) | generator.next();
+        return low + static_cast<std::ptrdiff_t>(bits % range);
+    }
 
     // Quick Sort implementation
-    int partition(std::vector<int>& arr, int low, int high, PivotStrategy pivot_strategy) {
-        // Step 1: Choose pivot based on strategy (First, Last, or Random)
-        int pivot_index;
+    const int NINTHER_THRESHOLD = 128;      // Below this many elements NINTHER samples three elements instead of nine
+
+    // Returns the index of the median of arr[a], arr[b] and arr[c]
+    std::ptrdiff_t median_of_three(const std::vector<int>& arr, std::ptrdiff_t a, std::ptrdiff_t b, std::ptrdiff_t c) {
+        if (arr[a] < arr[b]) {                                          // O(1)
+            if (arr[b] < arr[c]) return b;                              // a < b < c
+            return (arr[a] < arr[c]) ? c : a;                           // a < c <= b or c <= a < b
+        }
+        if (arr[a] < arr[c]) return a;                                  // b <= a < c
+        return (arr[b] < arr[c]) ? c : b;                               // b < c <= a or c <= b <= a
+    }
+
+    // Chooses the pivot index in arr[low..high] based on strategy (First, Last, Random, Median of three or Ninther)
+    std::ptrdiff_t select_pivot(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        std::ptrdiff_t pivot_index;
+        std::ptrdiff_t mid = low + (high - low) / 2;
         switch (pivot_strategy) {
+            case PivotStrategy::MEDIAN_OF_THREE:  // O(1)
+                pivot_index = median_of_three(arr, low, mid, high);    // O(1)
+                break;
+            case PivotStrategy::NINTHER:          // O(1)
+                if (high - low + 1 < NINTHER_THRESHOLD) {
+                    pivot_index = median_of_three(arr, low, mid, high);    // O(1)
+                }
+                else {
+                    // Tukey's ninther: median of the medians of three evenly spaced triples
+                    std::ptrdiff_t step = (high - low) / 8;             // O(1)
+                    std::ptrdiff_t m1 = median_of_three(arr, low, low + step, low + 2 * step);     // O(1)
+                    std::ptrdiff_t m2 = median_of_three(arr, mid - step, mid, mid + step);          // O(1)
+                    std::ptrdiff_t m3 = median_of_three(arr, high - 2 * step, high - step, high);   // O(1)
+                    pivot_index = median_of_three(arr, m1, m2, m3);                                 // O(1)
+                }
+                break;
             case PivotStrategy::FIRST:            // O(1)
                 pivot_index = low;               // O(1)
                 break;
@@ -99,22 +1080,25 @@ namespace sorting {
                 break;
             case PivotStrategy::RANDOM:           // O(1)
             default:                             // O(1)
-                std::random_device rd;           // O(1)
-                std::mt19937 gen(rd());          // O(1)
-                std::uniform_int_distribution<> dis(low, high); // O(1)
-                pivot_index = dis(gen);          // O(1)
+                pivot_index = random_index(low, high);  // O(1)
                 break;
         }
+        return pivot_index;
+    }
+
+    std::ptrdiff_t partition(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        // Step 1: Choose pivot based on strategy
+        std::ptrdiff_t pivot_index = select_pivot(arr, low, high, pivot_strategy);  // O(1)
 
         // Step 2: Swap pivot with last element
         std::swap(arr[pivot_index], arr[high]);  // O(1)
 
         // Step 3: Initialize pivot and `i`
         int pivot = arr[high];                 // O(1)
-        int i = low - 1;                      // O(1)
+        std::ptrdiff_t i = low - 1;           // O(1)
 
         // Step 4: Loop through the array to partition
-        for (int j = low; j <= high - 1; ++j) {    // O(n)
+        for (std::ptrdiff_t j = low; j <= high - 1; ++j) {   // O(n)
             if (arr[j] < pivot) {                   // O(1)
                 ++i;                                // O(1)
                 std::swap(arr[i], arr[j]);          // O(1)
@@ -126,10 +1110,14 @@ namespace sorting {
         return (i + 1);                        // O(1)
     }
 
-    void quick_sort(std::vector<int>& arr, int low, int high, PivotStrategy pivot_strategy) {
+    void quick_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        if (high - low + 1 <= small_sort_cutoff) {  // O(1) - small ranges are sorted in registers
+            network_sort(arr.data() + low, static_cast<int>(high - low + 1));
+            return;
+        }
         if (low < high) {                           // O(1) - base case check
             // Step 1: Partition the array
-			int pi = partition(arr, low, high, pivot_strategy);   // O(n) partitioning step this gets the pivot index
+			std::ptrdiff_t pi = partition(arr, low, high, pivot_strategy);   // O(n) partitioning step this gets the pivot index
 
             // Step 2: Recursively sort the left part
             quick_sort(arr, low, pi - 1, pivot_strategy);          // O(log n)
@@ -139,4 +1127,909 @@ namespace sorting {
         }
     }
 
+    // Three-Way Quick Sort implementation
+    // Dutch national flag partition (Dijkstra): afterwards arr[low..lt-1] < pivot, arr[lt..gt] == pivot
+    // and arr[gt+1..high] > pivot, so runs of equal keys are finished in a single pass
+    void partition_three_way(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, int pivot, std::ptrdiff_t& lt, std::ptrdiff_t& gt) {
+        // Grow the <, == and > regions until the unknown region arr[i..gt] is empty
+        lt = low;                                                       // O(1)
+        gt = high;                                                      // O(1)
+        std::ptrdiff_t i = low;                                         // O(1)
+        while (i <= gt) {                                               // O(n)
+            if (arr[i] < pivot)                                         // O(1)
+                std::swap(arr[lt++], arr[i++]);                         // O(1)
+            else if (pivot < arr[i])                                    // O(1)
+                std::swap(arr[i], arr[gt--]);                           // O(1) - arr[i] is new, don't advance
+            else
+                ++i;                                                    // O(1)
+        }
+    }
+
+    void partition_three_way(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy, std::ptrdiff_t& lt, std::ptrdiff_t& gt) {
+        // Step 1: Choose pivot based on strategy
+        int pivot = arr[select_pivot(arr, low, high, pivot_strategy)];  // O(1)
+
+        // Step 2: Split around it
+        partition_three_way(arr, low, high, pivot, lt, gt);             // O(n)
+    }
+
+    void quick_sort_three_way(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        while (low < high) {                                            // O(1) - base case check
+            if (high - low + 1 <= small_sort_cutoff) {                  // O(1) - small ranges are sorted in registers
+                network_sort(arr.data() + low, static_cast<int>(high - low + 1));
+                return;
+            }
+
+            // Step 1: Partition the array into <, == and > pivot
+            std::ptrdiff_t lt, gt;
+            partition_three_way(arr, low, high, pivot_strategy, lt, gt);    // O(n)
+
+            // Step 2: Recurse into the smaller outer part, loop on the larger one
+            if (lt - low < high - gt) {
+                quick_sort_three_way(arr, low, lt - 1, pivot_strategy);
+                low = gt + 1;
+            }
+            else {
+                quick_sort_three_way(arr, gt + 1, high, pivot_strategy);
+                high = lt - 1;
+            }
+        }
+    }
+
+    // Block Quick Sort implementation
+    const int PARTITION_BLOCK_SIZE = 64;    // Offsets per block, fits an unsigned char and two blocks stay in L1
+
+    // Branch-free block partition (Edelkamp & Weiss, BlockQuicksort 2016). Instead of branching on every
+    // comparison, the offsets of misplaced elements in a block from each end are recorded branch-free
+    // (the comparison result is added to the counter), then the misplaced pairs are swapped in bulk.
+    std::ptrdiff_t partition_block(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        // Step 1: Choose pivot and move it out of the way to the end
+        std::ptrdiff_t pivot_index = select_pivot(arr, low, high, pivot_strategy);   // O(1)
+        std::swap(arr[pivot_index], arr[high]);                             // O(1)
+        const int pivot = arr[high];                                        // O(1)
+
+        // Step 2: Partition arr[low..high-1] from both ends, one block at a time
+        int* first = arr.data() + low;                                      // Everything left of first is < pivot
+        int* last = arr.data() + high;                                      // Everything from last on is >= pivot
+        unsigned char offsets_left[PARTITION_BLOCK_SIZE];
+        unsigned char offsets_right[PARTITION_BLOCK_SIZE];
+        int num_left = 0, num_right = 0, start_left = 0, start_right = 0;
+
+        while (last - first > 2 * PARTITION_BLOCK_SIZE) {                   // O(n)
+            if (num_left == 0) {
+                start_left = 0;
+                for (int i = 0; i < PARTITION_BLOCK_SIZE; ++i) {            // O(B) - no branch on the comparison
+                    offsets_left[num_left] = static_cast<unsigned char>(i);
+                    num_left += !(first[i] < pivot);
+                }
+            }
+            if (num_right == 0) {
+                start_right = 0;
+                for (int i = 0; i < PARTITION_BLOCK_SIZE; ++i) {            // O(B) - no branch on the comparison
+                    offsets_right[num_right] = static_cast<unsigned char>(i);
+                    num_right += (last[-1 - i] < pivot);
+                }
+            }
+
+            // Swap as many misplaced pairs as both blocks have
+            int num = std::min(num_left, num_right);
+            for (int k = 0; k < num; ++k)                                   // O(B)
+                std::swap(first[offsets_left[start_left + k]], last[-1 - offsets_right[start_right + k]]);
+
+            num_left -= num;
+            num_right -= num;
+            start_left += num;
+            start_right += num;
+            if (num_left == 0) first += PARTITION_BLOCK_SIZE;               // Left block fully partitioned
+            if (num_right == 0) last -= PARTITION_BLOCK_SIZE;               // Right block fully partitioned
+        }
+
+        // Step 3: At most two blocks are left in the middle, finish them like Lomuto
+        int* split = first;
+        for (int* it = first; it < last; ++it) {                            // O(B)
+            if (*it < pivot)
+                std::swap(*split++, *it);
+        }
+
+        // Step 4: Swap pivot into its correct position
+        std::swap(*split, arr[high]);                                       // O(1)
+        return split - arr.data();                                          // O(1)
+    }
+
+    void quick_sort_block(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        while (low < high) {                                                // O(1) - base case check
+            if (high - low + 1 <= small_sort_cutoff) {                      // O(1) - small ranges are sorted in registers
+                network_sort(arr.data() + low, static_cast<int>(high - low + 1));
+                return;
+            }
+            std::ptrdiff_t pi = partition_block(arr, low, high, pivot_strategy);   // O(n)
+
+            // Recurse into the smaller part, loop on the larger one
+            if (pi - low < high - pi) {
+                quick_sort_block(arr, low, pi - 1, pivot_strategy);
+                low = pi + 1;
+            }
+            else {
+                quick_sort_block(arr, pi + 1, high, pivot_strategy);
+                high = pi - 1;
+            }
+        }
+    }
+
+    void quick_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy, PartitionScheme partition_scheme) {
+        switch (partition_scheme) {
+            case PartitionScheme::THREE_WAY:
+                quick_sort_three_way(arr, low, high, pivot_strategy);
+                break;
+            case PartitionScheme::BLOCK:
+                quick_sort_block(arr, low, high, pivot_strategy);
+                break;
+            case PartitionScheme::LOMUTO:
+            default:
+                quick_sort(arr, low, high, pivot_strategy);
+                break;
+        }
+    }
+
+
+    // Heap Sort implementation (used by intro_sort as its worst-case fallback)
+    // Restores the max-heap property for the subtree rooted at root, heap stored in arr[low..low+size-1]
+    void sift_down(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t root, std::ptrdiff_t size) {
+        int value = arr[low + root];                                    // O(1)
+        while (2 * root + 1 < size) {                                   // O(log n) - walks down one level per iteration
+            std::ptrdiff_t child = 2 * root + 1;                        // O(1) - left child
+            if (child + 1 < size && arr[low + child] < arr[low + child + 1])
+                ++child;                                                // O(1) - pick the larger child
+            if (!(value < arr[low + child]))
+                break;                                                  // O(1) - heap property holds
+            arr[low + root] = arr[low + child];                         // O(1) - move child up
+            root = child;                                               // O(1)
+        }
+        arr[low + root] = value;                                        // O(1)
+    }
+
+    void heap_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high) {
+        std::ptrdiff_t size = high - low + 1;                           // O(1)
+
+        // Step 1: Build a max-heap bottom up
+        for (std::ptrdiff_t root = size / 2 - 1; root >= 0; --root)     // O(n)
+            sift_down(arr, low, root, size);                            // O(log n)
+
+        // Step 2: Repeatedly move the maximum to the end of the shrinking heap
+        for (std::ptrdiff_t end = size - 1; end > 0; --end) {           // O(n)
+            std::swap(arr[low], arr[low + end]);                        // O(1)
+            sift_down(arr, low, 0, end);                                // O(log n)
+        }
+    }
+
+    // Intro Sort implementation
+    const int INSERTION_SORT_THRESHOLD = 16;    // Ranges this small are finished with insertion sort
+
+    void intro_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy, int depth_limit) {
+        while (high - low + 1 > INSERTION_SORT_THRESHOLD) {            // O(1) - small ranges are left for insertion sort
+            // Step 1: Quick sort has gone too deep, the pivots are bad so switch to heap sort
+            if (depth_limit == 0) {
+                heap_sort(arr, low, high);                              // O(n log n) - guaranteed
+                return;
+            }
+            --depth_limit;
+
+            // Step 2: Partition like quick sort
+            std::ptrdiff_t pi = partition(arr, low, high, pivot_strategy);   // O(n)
+
+            // Step 3: Recurse into the smaller part, loop on the larger part to keep the stack O(log n)
+            if (pi - low < high - pi) {
+                intro_sort(arr, low, pi - 1, pivot_strategy, depth_limit);
+                low = pi + 1;
+            }
+            else {
+                intro_sort(arr, pi + 1, high, pivot_strategy, depth_limit);
+                high = pi - 1;
+            }
+        }
+        insertion_sort(arr, low, high);                                 // O(k^2) for k <= INSERTION_SORT_THRESHOLD
+    }
+
+    void intro_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        if (low >= high) return;                                        // O(1)
+
+        // Depth limit 2 * floor(log2(n)), after that the partitions are considered degenerate
+        int depth_limit = 0;
+        for (std::ptrdiff_t n = high - low + 1; n > 1; n >>= 1)        // O(log n)
+            depth_limit += 2;
+
+        intro_sort(arr, low, high, pivot_strategy, depth_limit);
+    }
+
+    // Intro Select implementation (Musser 1997, median of medians by Blum, Floyd, Pratt, Rivest & Tarjan 1973)
+    const int MEDIAN_OF_MEDIANS_GROUP = 5;      // Group size of the median of medians pivot
+
+    void intro_select(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, std::ptrdiff_t k, PivotStrategy pivot_strategy, int depth_limit);
+
+    // Returns the median of the medians of groups of five in arr[low..high], a pivot with at least 30% of
+    // the range on either side. The group medians are gathered at the front of the range.
+    int median_of_medians(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        std::ptrdiff_t groups = 0;
+        for (std::ptrdiff_t first = low; first <= high; first += MEDIAN_OF_MEDIANS_GROUP) {   // O(n)
+            std::ptrdiff_t last = std::min<std::ptrdiff_t>(first + MEDIAN_OF_MEDIANS_GROUP - 1, high);
+            insertion_sort(arr, first, last);                                               // O(1) - at most 5 elements
+            std::swap(arr[low + groups++], arr[first + (last - first) / 2]);                // O(1)
+        }
+
+        // Select the median of the group medians with a fresh depth budget
+        std::ptrdiff_t middle = low + (groups - 1) / 2;
+        int depth_limit = 0;
+        for (std::ptrdiff_t n = groups; n > 1; n >>= 1)
+            depth_limit += 2;
+        intro_select(arr, low, low + groups - 1, middle, pivot_strategy, depth_limit);      // O(n / 5)
+        return arr[middle];
+    }
+
+    void intro_select(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, std::ptrdiff_t k, PivotStrategy pivot_strategy, int depth_limit) {
+        while (high - low + 1 > INSERTION_SORT_THRESHOLD) {            // O(1) - small ranges are left for insertion sort
+            // Step 1: Partition like quick sort, only the side holding k is kept
+            if (depth_limit > 0) {
+                --depth_limit;
+                std::ptrdiff_t pi = partition(arr, low, high, pivot_strategy);   // O(n)
+                if (k == pi) return;
+                if (k < pi) high = pi - 1;
+                else low = pi + 1;
+                continue;
+            }
+
+            // Step 2: Too many bad pivots, fall back to a median of medians pivot and a three-way split,
+            // which also settles runs of keys equal to the pivot that make the two-way partition degenerate
+            std::ptrdiff_t lt, gt;
+            partition_three_way(arr, low, high, median_of_medians(arr, low, high, pivot_strategy), lt, gt);  // O(n)
+            if (k < lt) high = lt - 1;
+            else if (k > gt) low = gt + 1;
+            else return;
+        }
+        insertion_sort(arr, low, high);                                 // O(k^2) for k <= INSERTION_SORT_THRESHOLD
+    }
+
+    void intro_select(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, std::ptrdiff_t k, PivotStrategy pivot_strategy) {
+        if (low >= high || k < low || k > high) return;                 // O(1)
+
+        // Same depth limit as intro_sort, 2 * floor(log2(n))
+        int depth_limit = 0;
+        for (std::ptrdiff_t n = high - low + 1; n > 1; n >>= 1)        // O(log n)
+            depth_limit += 2;
+
+        intro_select(arr, low, high, k, pivot_strategy, depth_limit);   // O(n)
+    }
+
+    void partial_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, std::ptrdiff_t k) {
+        if (k <= 0 || low > high) return;                               // O(1)
+        if (k >= high - low + 1) {
+            pdq_sort(arr, low, high);                                   // O(n log n) - everything is wanted
+            return;
+        }
+
+        // Step 1: Move the k smallest to the front, arr[low + k - 1] is already in its final place
+        intro_select(arr, low, high, low + k - 1, PivotStrategy::MEDIAN_OF_THREE);  // O(n)
+
+        // Step 2: Sort only those
+        pdq_sort(arr, low, low + k - 2);                                // O(k log k)
+    }
+
+    // Streaming Top-K implementation
+    StreamingTopK::StreamingTopK(std::size_t k)
+        : m_K(k) {
+        m_Heap.reserve(k);
+    }
+
+    void StreamingTopK::push(int value) {
+        if (m_Heap.size() < m_K) {
+            m_Heap.push_back(value);                                    // O(log k) - fill the max-heap
+            std::push_heap(m_Heap.begin(), m_Heap.end());
+        }
+        else if (m_K > 0 && value < m_Heap[0]) {                        // O(1) - most values can't beat the current k-th smallest
+            m_Heap[0] = value;                                          // O(log k) - replace the largest and restore the heap
+            sift_down(m_Heap, 0, 0, static_cast<std::ptrdiff_t>(m_K));
+        }
+    }
+
+    void StreamingTopK::push(const int* values, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i)                         // O(count log k) worst case
+            push(values[i]);
+    }
+
+    std::vector<int> StreamingTopK::sorted() const {
+        std::vector<int> result(m_Heap);
+        std::sort_heap(result.begin(), result.end());                   // O(k log k) - a max-heap sorts ascending
+        return result;
+    }
+
+    // Pattern-Defeating Quick Sort implementation (Orson Peters, pdqsort)
+    const int PDQ_INSERTION_SORT_THRESHOLD = 24;        // Ranges smaller than this are insertion sorted
+    const int PDQ_NINTHER_THRESHOLD = 128;              // Ranges bigger than this use a ninther pivot
+    const int PDQ_PARTIAL_INSERTION_SORT_LIMIT = 8;     // Element moves before partial insertion sort gives up
+
+    // Sorts arr[a] <= arr[b]
+    void sort2(std::vector<int>& arr, std::ptrdiff_t a, std::ptrdiff_t b) {
+        if (arr[b] < arr[a]) std::swap(arr[a], arr[b]);                // O(1)
+    }
+
+    // Sorts arr[a] <= arr[b] <= arr[c]
+    void sort3(std::vector<int>& arr, std::ptrdiff_t a, std::ptrdiff_t b, std::ptrdiff_t c) {
+        sort2(arr, a, b);                                               // O(1)
+        sort2(arr, b, c);                                               // O(1)
+        sort2(arr, a, b);                                               // O(1)
+    }
+
+    // Insertion sort that gives up after PDQ_PARTIAL_INSERTION_SORT_LIMIT moves.
+    // Returns true if arr[low..high] is sorted afterwards.
+    bool partial_insertion_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high) {
+        std::ptrdiff_t moves = 0;
+        for (std::ptrdiff_t i = low + 1; i <= high; ++i) {              // O(n) when nearly sorted
+            int key = arr[i];
+            std::ptrdiff_t j = i - 1;
+            while (j >= low && key < arr[j]) {
+                arr[j + 1] = arr[j];
+                --j;
+            }
+            arr[j + 1] = key;
+            moves += i - 1 - j;
+            if (moves > PDQ_PARTIAL_INSERTION_SORT_LIMIT) return false;
+        }
+        return true;
+    }
+
+    // Partitions arr[low..high] around the pivot arr[low] with elements equal to the pivot going right.
+    // Returns the final pivot position and sets already_partitioned if no element had to be swapped.
+    // Needs an element >= pivot in arr[low+1..high], which the median-of-three pivot choice guarantees.
+    std::ptrdiff_t pdq_partition_right(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, bool& already_partitioned) {
+        const int pivot = arr[low];
+        std::ptrdiff_t first = low;
+        std::ptrdiff_t last = high + 1;
+
+        // Step 1: Find the first element >= pivot and the last element < pivot
+        while (arr[++first] < pivot);
+        if (first - 1 == low) {
+            while (first < last && !(arr[--last] < pivot));             // No smaller element seen yet, guard the scan
+        }
+        else {
+            while (!(arr[--last] < pivot));                             // arr[first-1] < pivot stops the scan
+        }
+
+        // Step 2: If the scans crossed, nothing is misplaced
+        already_partitioned = first >= last;
+
+        // Step 3: Hoare-style swapping of misplaced pairs
+        while (first < last) {
+            std::swap(arr[first], arr[last]);
+            while (arr[++first] < pivot);
+            while (!(arr[--last] < pivot));
+        }
+
+        // Step 4: Move the pivot into place
+        std::ptrdiff_t pivot_pos = first - 1;
+        arr[low] = arr[pivot_pos];
+        arr[pivot_pos] = pivot;
+        return pivot_pos;
+    }
+
+    // Partitions arr[low..high] around the pivot arr[low] with elements equal to the pivot going left.
+    // Used when the pivot equals the element before the range, all equal keys are then done in one pass.
+    std::ptrdiff_t pdq_partition_left(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high) {
+        const int pivot = arr[low];
+        std::ptrdiff_t first = low;
+        std::ptrdiff_t last = high + 1;
+
+        while (pivot < arr[--last]);
+        if (last == high) {
+            while (first < last && !(pivot < arr[++first]));
+        }
+        else {
+            while (!(pivot < arr[++first]));
+        }
+
+        while (first < last) {
+            std::swap(arr[first], arr[last]);
+            while (pivot < arr[--last]);
+            while (!(pivot < arr[++first]));
+        }
+
+        arr[low] = arr[last];
+        arr[last] = pivot;
+        return last;
+    }
+
+    void pdq_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, int bad_allowed, bool leftmost) {
+        while (true) {
+            std::ptrdiff_t size = high - low + 1;
+
+            // Step 1: Small ranges are insertion sorted
+            if (size < PDQ_INSERTION_SORT_THRESHOLD) {
+                insertion_sort(arr, low, high);                         // O(k^2) for small k
+                return;
+            }
+
+            // Step 2: Median of three (or ninther for large ranges) moved to arr[low]
+            std::ptrdiff_t s2 = low + size / 2;
+            if (size > PDQ_NINTHER_THRESHOLD) {
+                sort3(arr, low, s2, high);
+                sort3(arr, low + 1, s2 - 1, high - 1);
+                sort3(arr, low + 2, s2 + 1, high - 2);
+                sort3(arr, s2 - 1, s2, s2 + 1);
+                std::swap(arr[low], arr[s2]);
+            }
+            else {
+                sort3(arr, s2, low, high);
+            }
+
+            // Step 3: If the pivot equals the element before this range (which is <= everything in it),
+            // there are many equal keys: put them all left of the pivot and skip them
+            if (!leftmost && !(arr[low - 1] < arr[low])) {
+                low = pdq_partition_left(arr, low, high) + 1;
+                continue;
+            }
+
+            // Step 4: Partition and measure the balance
+            bool already_partitioned;
+            std::ptrdiff_t pivot_pos = pdq_partition_right(arr, low, high, already_partitioned);
+            std::ptrdiff_t left_size = pivot_pos - low;
+            std::ptrdiff_t right_size = high - pivot_pos;
+            bool highly_unbalanced = left_size < size / 8 || right_size < size / 8;
+
+            if (highly_unbalanced) {
+                // Step 5a: Too many bad partitions, switch to heap sort for guaranteed O(n log n)
+                if (--bad_allowed == 0) {
+                    heap_sort(arr, low, high);
+                    return;
+                }
+
+                // Shuffle a few elements around to break up patterns that produce bad pivots
+                if (left_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                    std::swap(arr[low], arr[low + left_size / 4]);
+                    std::swap(arr[pivot_pos - 1], arr[pivot_pos - left_size / 4]);
+                    if (left_size > PDQ_NINTHER_THRESHOLD) {
+                        std::swap(arr[low + 1], arr[low + (left_size / 4 + 1)]);
+                        std::swap(arr[low + 2], arr[low + (left_size / 4 + 2)]);
+                        std::swap(arr[pivot_pos - 2], arr[pivot_pos - (left_size / 4 + 1)]);
+                        std::swap(arr[pivot_pos - 3], arr[pivot_pos - (left_size / 4 + 2)]);
+                    }
+                }
+                if (right_size >= PDQ_INSERTION_SORT_THRESHOLD) {
+                    std::swap(arr[pivot_pos + 1], arr[pivot_pos + (1 + right_size / 4)]);
+                    std::swap(arr[high], arr[high + 1 - right_size / 4]);
+                    if (right_size > PDQ_NINTHER_THRESHOLD) {
+                        std::swap(arr[pivot_pos + 2], arr[pivot_pos + (2 + right_size / 4)]);
+                        std::swap(arr[pivot_pos + 3], arr[pivot_pos + (3 + right_size / 4)]);
+                        std::swap(arr[high - 1], arr[high - right_size / 4]);
+                        std::swap(arr[high - 2], arr[high - (1 + right_size / 4)]);
+                    }
+                }
+            }
+            else {
+                // Step 5b: A balanced partition that swapped nothing suggests sorted input, try to finish cheaply
+                if (already_partitioned
+                    && partial_insertion_sort(arr, low, pivot_pos - 1)
+                    && partial_insertion_sort(arr, pivot_pos + 1, high))
+                    return;
+            }
+
+            // Step 6: Recurse into the left part and loop on the right part
+            pdq_sort(arr, low, pivot_pos - 1, bad_allowed, leftmost);
+            low = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+
+    void pdq_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high) {
+        if (low >= high) return;                                        // O(1)
+
+        // Allow log2(n) highly unbalanced partitions before falling back to heap sort
+        int bad_allowed = 0;
+        for (std::ptrdiff_t n = high - low + 1; n > 1; n >>= 1)        // O(log n)
+            ++bad_allowed;
+
+        pdq_sort(arr, low, high, bad_allowed, true);
+    }
+
+    // Parallel Quick Sort implementation
+    const int PARALLEL_PARTITION_CUTOFF = 1 << 18;  // Ranges at least this big are partitioned by several threads
+
+    // Sequential quick sort that recurses into the smaller side and loops on the larger one,
+    // so a task never needs more than O(log n) stack even with a bad pivot strategy
+    void quick_sort_bounded_stack(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        while (low < high) {
+            std::ptrdiff_t pi = partition(arr, low, high, pivot_strategy);
+            if (pi - low < high - pi) {
+                quick_sort_bounded_stack(arr, low, pi - 1, pivot_strategy);
+                low = pi + 1;
+            }
+            else {
+                quick_sort_bounded_stack(arr, pi + 1, high, pivot_strategy);
+                high = pi - 1;
+            }
+        }
+    }
+
+    // In-place partition of arr[low..high] using every thread of the pool:
+    // 1. every block of arr[low..high-1] is Lomuto-partitioned by its own task,
+    // 2. the greater elements left of the final split are paired with the smaller elements right of it,
+    // 3. those pairs are swapped in parallel chunks.
+    std::ptrdiff_t parallel_partition(ThreadPool& pool, std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        std::ptrdiff_t pivot_index = select_pivot(arr, low, high, pivot_strategy);
+        std::swap(arr[pivot_index], arr[high]);
+        const int pivot = arr[high];
+        const std::ptrdiff_t n = high - low;                        // Elements in arr[low..high-1]
+        const int blocks = static_cast<int>(pool.Size());
+
+        // Step 1: Partition every block independently and count its smaller elements
+        std::vector<std::ptrdiff_t> less_count(blocks);
+        {
+            TaskGroup group(pool);
+            for (int b = 0; b < blocks; ++b) {
+                group.Run([&, b] {
+                    std::ptrdiff_t begin = low + n * b / blocks;
+                    std::ptrdiff_t end = low + n * (b + 1) / blocks;
+                    std::ptrdiff_t i = begin;
+                    for (std::ptrdiff_t j = begin; j < end; ++j) {
+                        if (arr[j] < pivot) {
+                            std::swap(arr[i], arr[j]);
+                            ++i;
+                        }
+                    }
+                    less_count[b] = i - begin;
+                });
+            }
+            group.Wait();
+        }
+
+        // Step 2: Collect misplaced elements, both lists hold the same number of elements
+        struct Span { std::ptrdiff_t begin, length; };
+        std::vector<Span> misplaced_greater, misplaced_less;
+        std::ptrdiff_t split = low;
+        for (int b = 0; b < blocks; ++b)
+            split += less_count[b];
+
+        std::ptrdiff_t misplaced = 0;
+        for (int b = 0; b < blocks; ++b) {
+            std::ptrdiff_t begin = low + n * b / blocks;
+            std::ptrdiff_t end = low + n * (b + 1) / blocks;
+            std::ptrdiff_t middle = begin + less_count[b];
+
+            // Greater elements [middle, end) that lie left of split
+            std::ptrdiff_t greater_end = std::min(end, split);
+            if (middle < greater_end) {
+                misplaced_greater.push_back({ middle, greater_end - middle });
+                misplaced += greater_end - middle;
+            }
+            // Smaller elements [begin, middle) that lie right of split
+            std::ptrdiff_t less_begin = std::max(begin, split);
+            if (less_begin < middle)
+                misplaced_less.push_back({ less_begin, middle - less_begin });
+        }
+
+        // Step 3: Swap the k-th misplaced greater element with the k-th misplaced smaller element
+        if (misplaced > 0) {
+            const int chunks = static_cast<int>(std::min<std::ptrdiff_t>(blocks, misplaced));
+            TaskGroup group(pool);
+            for (int c = 0; c < chunks; ++c) {
+                group.Run([&, c] {
+                    std::ptrdiff_t w0 = misplaced * c / chunks;
+                    std::ptrdiff_t w1 = misplaced * (c + 1) / chunks;
+
+                    // Locate element w0 in both span lists
+                    size_t g = 0, l = 0;
+                    std::ptrdiff_t g_offset = w0, l_offset = w0;
+                    while (g_offset >= misplaced_greater[g].length) g_offset -= misplaced_greater[g++].length;
+                    while (l_offset >= misplaced_less[l].length) l_offset -= misplaced_less[l++].length;
+
+                    for (std::ptrdiff_t w = w0; w < w1; ++w) {
+                        std::swap(arr[misplaced_greater[g].begin + g_offset], arr[misplaced_less[l].begin + l_offset]);
+                        if (++g_offset == misplaced_greater[g].length) { ++g; g_offset = 0; }
+                        if (++l_offset == misplaced_less[l].length) { ++l; l_offset = 0; }
+                    }
+                });
+            }
+            group.Wait();
+        }
+
+        // Step 4: Swap pivot into its correct position
+        std::swap(arr[split], arr[high]);
+        return split;
+    }
+
+    void parallel_quick_sort_range(ThreadPool& pool, std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy) {
+        TaskGroup group(pool);
+        while (high - low + 1 > PARALLEL_SORT_CUTOFF) {
+            std::ptrdiff_t pi = (high - low + 1 >= PARALLEL_PARTITION_CUTOFF)
+                ? parallel_partition(pool, arr, low, high, pivot_strategy)
+                : partition(arr, low, high, pivot_strategy);
+
+            // Fork the smaller side and keep working on the larger one
+            std::ptrdiff_t task_low = low, task_high = pi - 1;
+            if (pi - low < high - pi) {
+                low = pi + 1;
+            }
+            else {
+                task_low = pi + 1;
+                task_high = high;
+                high = pi - 1;
+            }
+
+            if (task_high - task_low + 1 > PARALLEL_SORT_CUTOFF)
+                group.Run([&pool, &arr, task_low, task_high, pivot_strategy] {
+                    parallel_quick_sort_range(pool, arr, task_low, task_high, pivot_strategy);
+                });
+            else
+                quick_sort_bounded_stack(arr, task_low, task_high, pivot_strategy);
+        }
+        quick_sort_bounded_stack(arr, low, high, pivot_strategy);
+        group.Wait();
+    }
+
+    void parallel_quick_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy, unsigned int num_threads) {
+        if (low >= high) return;
+
+        std::shared_ptr<ThreadPool> shared_pool = get_thread_pool(num_threads);  // Keeps the pool alive for this call
+        parallel_quick_sort_range(*shared_pool, arr, low, high, pivot_strategy);
+    }
+
+    // Parallel Sample Sort implementation (Super Scalar Sample Sort, Sanders & Winkel 2004)
+    const int SAMPLE_SORT_OVERSAMPLING = 16;        // Samples per bucket, more samples give more even buckets
+    const int SAMPLE_SORT_BUCKETS_PER_THREAD = 4;   // Spare buckets let idle threads pick up work when buckets are uneven
+    const int SAMPLE_SORT_MAX_BUCKETS = 128;        // Bucket ids, two per bucket with equality buckets, are stored in one byte
+
+    // Lays the sorted splitters[lo..hi) out as an implicit binary search tree, node i has children 2i and 2i+1
+    void build_splitter_tree(std::vector<int>& tree, const std::vector<int>& splitters, std::ptrdiff_t node, std::ptrdiff_t lo, std::ptrdiff_t hi) {
+        if (lo >= hi) return;
+        std::ptrdiff_t mid = lo + (hi - lo) / 2;
+        tree[node] = splitters[mid];
+        build_splitter_tree(tree, splitters, 2 * node, lo, mid);
+        build_splitter_tree(tree, splitters, 2 * node + 1, mid + 1, hi);
+    }
+
+    void parallel_sample_sort(std::vector<int>& data, unsigned int num_threads) {
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(data.size());
+        std::shared_ptr<ThreadPool> shared_pool = get_thread_pool(num_threads);  // Keeps the pool alive for this call
+        ThreadPool& pool = *shared_pool;
+        const int threads = static_cast<int>(pool.Size());
+        if (threads == 1 || n <= PARALLEL_SORT_CUTOFF) {
+            std::vector<int> buffer;
+            merge_sort(data, buffer);
+            return;
+        }
+
+        // Step 1: Pick a power-of-two bucket count so classification is a fixed number of tree levels
+        int log_buckets = 1;
+        while ((1 << log_buckets) < threads * SAMPLE_SORT_BUCKETS_PER_THREAD && (1 << log_buckets) < SAMPLE_SORT_MAX_BUCKETS)
+            ++log_buckets;
+        const int buckets = 1 << log_buckets;
+
+        // Step 2: Sort an oversampled random sample and take every SAMPLE_SORT_OVERSAMPLING-th element as a splitter
+        std::vector<int> sample(static_cast<std::size_t>(buckets) * SAMPLE_SORT_OVERSAMPLING);
+        for (int& value : sample)
+            value = data[random_index(0, n - 1)];                                  // O(1) per sample
+        pdq_sort(sample, 0, static_cast<std::ptrdiff_t>(sample.size()) - 1);       // O(b log b)
+        std::vector<int> splitters(buckets - 1);
+        for (int i = 0; i < buckets - 1; ++i)
+            splitters[i] = sample[(i + 1) * SAMPLE_SORT_OVERSAMPLING];
+        std::vector<int> tree(buckets);
+        build_splitter_tree(tree, splitters, 1, 0, buckets - 1);
+
+        // Step 2b: Equal splitters mean a heavy key. Every bucket then gets an equality bucket after it for the keys
+        // equal to its upper splitter, so bucket b becomes id 2b (keys strictly between the splitters) and 2b + 1
+        // (keys equal to the upper splitter). Equality buckets are already sorted and never reach a sort task.
+        const bool equality_buckets = std::adjacent_find(splitters.begin(), splitters.end()) != splitters.end();
+        const int ids = equality_buckets ? 2 * buckets : buckets;
+        std::vector<int> upper_splitter(splitters);
+        upper_splitter.push_back(INT_MAX);                                             // The last bucket has no upper splitter
+
+        // Step 3: Classify one block per thread, remembering every bucket id and counting bucket sizes
+        std::vector<std::uint8_t> oracle(n);
+        std::vector<std::ptrdiff_t> offsets(static_cast<std::size_t>(threads) * ids, 0);   // Histogram of block t at [t * ids]
+        {
+            TaskGroup group(pool);
+            for (int t = 0; t < threads; ++t) {
+                group.Run([&, t] {
+                    std::ptrdiff_t* histogram = offsets.data() + static_cast<std::size_t>(t) * ids;
+                    for (std::ptrdiff_t i = n * t / threads; i < n * (t + 1) / threads; ++i) {  // O(n/p log b)
+                        std::ptrdiff_t node = 1;
+                        for (int level = 0; level < log_buckets; ++level)
+                            node = 2 * node + (data[i] > tree[node]);                          // O(1) - branch free
+                        std::ptrdiff_t id = node - buckets;
+                        if (equality_buckets)                                                  // O(1) - same outcome for the whole call
+                            id = 2 * id + (data[i] == upper_splitter[id]);
+                        oracle[i] = static_cast<std::uint8_t>(id);
+                        ++histogram[id];
+                    }
+                });
+            }
+            group.Wait();
+        }
+
+        // Step 4: Exclusive prefix sum, bucket-major, gives every block its write position inside every bucket
+        std::vector<std::ptrdiff_t> bucket_begin(ids + 1);
+        std::ptrdiff_t sum = 0;
+        for (int b = 0; b < ids; ++b) {                                                // O(p * b)
+            bucket_begin[b] = sum;
+            for (int t = 0; t < threads; ++t) {
+                std::ptrdiff_t count = offsets[static_cast<std::size_t>(t) * ids + b];
+                offsets[static_cast<std::size_t>(t) * ids + b] = sum;
+                sum += count;
+            }
+        }
+        bucket_begin[ids] = n;
+
+        // Step 5: Scatter every element to its bucket in a single pass
+        std::vector<int> buffer(n);
+        {
+            TaskGroup group(pool);
+            for (int t = 0; t < threads; ++t) {
+                group.Run([&, t] {
+                    std::ptrdiff_t* position = offsets.data() + static_cast<std::size_t>(t) * ids;
+                    for (std::ptrdiff_t i = n * t / threads; i < n * (t + 1) / threads; ++i)  // O(n/p)
+                        buffer[position[oracle[i]]++] = data[i];
+                });
+            }
+            group.Wait();
+        }
+
+        // Step 6: Copy every bucket back and merge sort it with its slice of the buffer as scratch, buckets are independent.
+        // An equality bucket holds one key only, so it is filled with that key in chunks of n/p instead of being sorted.
+        {
+            TaskGroup group(pool);
+            const std::ptrdiff_t chunk = (n + threads - 1) / threads;
+            for (int b = 0; b < ids; ++b) {
+                if (bucket_begin[b] == bucket_begin[b + 1]) continue;                   // O(1) - empty bucket
+                if (equality_buckets && (b & 1)) {
+                    const int key = upper_splitter[b / 2];
+                    for (std::ptrdiff_t low = bucket_begin[b]; low < bucket_begin[b + 1]; low += chunk) {
+                        std::ptrdiff_t high = std::min(low + chunk, bucket_begin[b + 1]);
+                        group.Run([&data, key, low, high] {
+                            std::fill(data.begin() + low, data.begin() + high, key);  // O(n/p)
+                        });
+                    }
+                    continue;
+                }
+                group.Run([&, b] {
+                    std::ptrdiff_t low = bucket_begin[b];
+                    std::ptrdiff_t high = bucket_begin[b + 1] - 1;
+                    std::copy(buffer.begin() + low, buffer.begin() + high + 1, data.begin() + low);  // O(n/b)
+                    merge_sort_ping_pong(buffer.data(), data.data(), low, high);                     // O(n/b log(n/b))
+                });
+            }
+            group.Wait();
+        }
+    }
+
+    // Segmented Sort implementation
+    const int SEGMENTED_INSERTION_MAX = 8;                      // Segments up to this length skip the network kernel, its padding costs more
+    const std::ptrdiff_t SEGMENTED_TASK_ELEMENTS = 1 << 15;     // Consecutive segments are batched into tasks of about this many elements
+
+    // Sorts one segment, scratch is grown to the longest segment seen and reused for the rest
+    void sort_segment(int* data, std::ptrdiff_t n, std::vector<int>& scratch) {
+        if (n <= SEGMENTED_INSERTION_MAX) {                         // O(n^2) for tiny n, no call or padding overhead
+            for (std::ptrdiff_t i = 1; i < n; ++i) {
+                int key = data[i];
+                std::ptrdiff_t j = i - 1;
+                while (j >= 0 && data[j] > key) {
+                    data[j + 1] = data[j];
+                    --j;
+                }
+                data[j + 1] = key;
+            }
+            return;
+        }
+        if (n <= SORTING_NETWORK_MAX) {                             // O(1) - sorted in registers
+            network_sort(data, static_cast<int>(n));
+            return;
+        }
+        if (static_cast<std::ptrdiff_t>(scratch.size()) < n)       // O(1) - only grows, so no allocation per segment
+            scratch.resize(n);
+        std::copy(data, data + n, scratch.data());                  // O(n)
+        merge_sort_ping_pong(scratch.data(), data, 0, n - 1);       // O(n log n)
+    }
+
+    // Sorts segments [first, last) one after another with a single scratch buffer
+    void sort_segments(int* data, const std::ptrdiff_t* offsets, std::size_t first, std::size_t last) {
+        std::vector<int> scratch;
+        for (std::size_t i = first; i < last; ++i)
+            sort_segment(data + offsets[i], offsets[i + 1] - offsets[i], scratch);
+    }
+
+    void segmented_sort(int* data, const std::ptrdiff_t* offsets, std::size_t num_segments, unsigned int num_threads) {
+        if (num_segments == 0) return;
+
+        const std::ptrdiff_t n = offsets[num_segments] - offsets[0];
+        std::shared_ptr<ThreadPool> shared_pool = get_thread_pool(num_threads);  // Keeps the pool alive for this call
+        ThreadPool& pool = *shared_pool;
+        if (pool.Size() == 1 || n <= PARALLEL_SORT_CUTOFF) {
+            sort_segments(data, offsets, 0, num_segments);
+            return;
+        }
+
+        // Cut the segments into batches of about SEGMENTED_TASK_ELEMENTS elements, a task per batch keeps the
+        // scheduling cost per segment low when segments are tiny and still balances when their lengths vary
+        TaskGroup group(pool);
+        std::size_t first = 0;
+        for (std::size_t i = 0; i < num_segments; ++i) {
+            if (offsets[i + 1] - offsets[first] >= SEGMENTED_TASK_ELEMENTS || i + 1 == num_segments) {
+                const std::size_t last = i + 1;
+                group.Run([=] { sort_segments(data, offsets, first, last); });
+                first = last;
+            }
+        }
+        group.Wait();
+    }
+
+    void segmented_sort(std::vector<int>& data, const std::vector<std::ptrdiff_t>& offsets, unsigned int num_threads) {
+        if (offsets.size() < 2) return;
+        segmented_sort(data.data(), offsets.data(), offsets.size() - 1, num_threads);
+    }
+
+    // LSD Radix Sort implementation
+    const int RADIX_BITS = 8;                           // Bits per digit
+    const int RADIX_BUCKETS = 1 << RADIX_BITS;          // 256 buckets, one histogram fits in L1
+    const int RADIX_PASSES = 32 / RADIX_BITS;           // 4 passes for 32-bit keys
+
+    // Maps a signed int to an unsigned key with the same order (flipping the sign bit puts negatives first)
+    inline std::uint32_t radix_key(int value) {
+        return static_cast<std::uint32_t>(value) ^ 0x80000000u;        // O(1)
+    }
+
+    // Thin wrapper, the generic radix sort picks 4 passes for int keys
+    void radix_sort(std::vector<int>& data) {
+        radix_sort(data.begin(), data.end());                          // O(n)
+    }
+
+    // American Flag Sort implementation (in-place MSD radix sort, McIlroy, Bostic & McIlroy 1993)
+    const int AMERICAN_FLAG_SORT_THRESHOLD = 32;    // Buckets this small are finished with insertion sort
+
+    // Sorts arr[low..high] by the digit at shift and recurses into every bucket with the next lower digit.
+    // Only three 256-entry tables on the stack per level (4 levels at most), no buffer proportional to n.
+    void american_flag_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, int shift) {
+        if (high - low + 1 <= AMERICAN_FLAG_SORT_THRESHOLD) {
+            insertion_sort(arr, low, high);                             // O(k^2) for small k
+            return;
+        }
+
+        // Step 1: Histogram of the current digit
+        std::ptrdiff_t counts[RADIX_BUCKETS] = {};
+        for (std::ptrdiff_t i = low; i <= high; ++i)                    // O(n)
+            ++counts[(radix_key(arr[i]) >> shift) & (RADIX_BUCKETS - 1)];
+
+        // Step 2: Bucket boundaries, heads[b] is the next unplaced slot of bucket b
+        std::ptrdiff_t heads[RADIX_BUCKETS], tails[RADIX_BUCKETS];
+        std::ptrdiff_t offset = low;
+        for (int b = 0; b < RADIX_BUCKETS; ++b) {                       // O(buckets)
+            heads[b] = offset;
+            offset += counts[b];
+            tails[b] = offset;
+        }
+
+        // Step 3: Permute in place by following cycles, every element is moved at most once
+        for (int b = 0; b < RADIX_BUCKETS; ++b) {                       // O(n) in total
+            while (heads[b] < tails[b]) {
+                int value = arr[heads[b]];
+                int digit = (radix_key(value) >> shift) & (RADIX_BUCKETS - 1);
+                while (digit != b) {                                    // Carry value to its bucket, pick up the occupant
+                    std::swap(value, arr[heads[digit]++]);
+                    digit = (radix_key(value) >> shift) & (RADIX_BUCKETS - 1);
+                }
+                arr[heads[b]++] = value;
+            }
+        }
+
+        // Step 4: Recurse into every bucket with the next digit
+        if (shift == 0) return;
+        std::ptrdiff_t start = low;
+        for (int b = 0; b < RADIX_BUCKETS; ++b) {                       // O(buckets)
+            if (counts[b] > 1)
+                american_flag_sort(arr, start, start + counts[b] - 1, shift - RADIX_BITS);
+            start += counts[b];
+        }
+    }
+
+    void american_flag_sort(std::vector<int>& data) {
+        if (data.size() < 2) return;                                    // O(1)
+
+        american_flag_sort(data, 0, static_cast<std::ptrdiff_t>(data.size()) - 1, 32 - RADIX_BITS);
+    }
+
 } // namespace sorting
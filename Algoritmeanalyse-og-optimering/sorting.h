@@ -3,27 +3,160 @@
 #ifndef SORTING_H
 #define SORTING_H
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace sorting {
+    // Function to set the range size up to which merge_sort and quick_sort stop recursing and sort the range
+    // with the SIMD sorting network kernel instead (clamped to 0..64, 0 disables it, default 32)
+    void set_small_sort_cutoff(int cutoff);
+
     // Function to perform merge sort on a vector of integers
     void merge_sort(std::vector<int>& data);
 
+    // Function to perform merge sort using a caller-provided scratch buffer.
+    // The buffer is resized to data.size() if needed and can be reused between calls,
+    // so repeated sorts do no heap allocations.
+    void merge_sort(std::vector<int>& data, std::vector<int>& buffer);
+
+    // Function to perform stable merge sort without an n-sized buffer: runs are sorted with insertion sort and
+    // merged bottom-up, a merge whose shorter run fits a fixed stack buffer is done through it and longer ones are
+    // split by binary search and rotated into place (O(n log^2 n) time, O(1) heap and O(log n) stack).
+    void in_place_merge_sort(std::vector<int>& data);
+
+    // Function to perform merge sort on a work-stealing thread pool.
+    // The two halves are sorted as parallel tasks and large merges are split with merge path (co-rank),
+    // num_threads = 0 uses every hardware thread.
+    void parallel_merge_sort(std::vector<int>& data, unsigned int num_threads = 0);
+
+    // A sorted run of ints, one input of kway_merge
+    struct SortedRun {
+        const int* data;
+        std::ptrdiff_t size;
+    };
+
+    // Function to merge k sorted runs into out with a tournament (loser) tree. Every output element replays
+    // log2(k) matches along one leaf-to-root path; keys and losers live in two flat arrays, so the tree for
+    // k = 1024 fits in L1. out must hold the total size of the runs. Every k >= 2 goes through the tree, for exactly
+    // two runs bitonic_merge is the faster choice.
+    void kway_merge(const std::vector<SortedRun>& runs, int* out);
+
+    // Per-core data cache sizes in bytes, 0 for a level the OS doesn't report
+    struct CacheSizes {
+        std::size_t l1;
+        std::size_t l2;
+        std::size_t l3;
+    };
+
+    // Function to query the cache sizes once (GetLogicalProcessorInformation on Windows, sysconf elsewhere),
+    // later calls return the cached result
+    const CacheSizes& detect_cache_sizes();
+
+    // Function to perform cache-blocked merge sort: blocks that fit in L2 together with their scratch half are merge
+    // sorted while they stay in cache, then the sorted blocks are combined with one or two multiway merge passes instead
+    // of log2(n / block) two-way passes over memory. A pass cuts its output into L2-sized tiles by multi-sequence
+    // selection and merges every tile pairwise in cache. block_elements = 0 derives the block size from detect_cache_sizes().
+    void cache_blocked_merge_sort(std::vector<int>& data, std::size_t block_elements = 0);
+
+    // Function to perform Tim Sort: stable natural merge sort that detects ascending and strictly descending
+    // runs, extends short runs with binary insertion and gallops through merges. O(n) on sorted and reversed input.
+    void tim_sort(std::vector<int>& data);
+
     // Enum for pivot selection strategy
     enum class PivotStrategy {
         RANDOM,
         LAST,
-		FIRST
+		FIRST,
+        MEDIAN_OF_THREE,    // Median of first, middle and last element
+        NINTHER             // Tukey's ninther (median of three medians of three) for large ranges
     };
 
+    // Function to seed the generator behind PivotStrategy::RANDOM for reproducible runs.
+    // Without it every thread seeds its own generator once from std::random_device.
+    void set_random_pivot_seed(std::uint64_t seed);
+
     // Function to set pivot strategy
     void set_pivot_strategy(PivotStrategy strategy);
 
     // Function to perform quick sort on a vector of integers
-    void quick_sort(std::vector<int>& arr, int low, int high, PivotStrategy pivot_strategy);
+    void quick_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy);
+
+    // Enum for partition scheme used by quick sort
+    enum class PartitionScheme {
+        LOMUTO,             // Two-way partition, equal keys all end up on one side
+        THREE_WAY,          // Dutch national flag partition into <, == and > pivot, for duplicate-heavy input
+        BLOCK               // Branch-free block partition (BlockQuicksort), avoids mispredicted comparisons
+    };
+
+    // Function to perform quick sort with a chosen partition scheme
+    void quick_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy, PartitionScheme partition_scheme);
+
+    // Function to perform introspective sort: quick sort that falls back to heap sort once the recursion
+    // goes deeper than 2 * log2(n) and finishes small ranges with insertion sort. Always O(n log n).
+    void intro_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy);
+
+    // Function to rearrange arr[low..high] so arr[k] (low <= k <= high) holds the value it would have after sorting,
+    // with nothing greater before it and nothing smaller after it (nth_element). Introselect: quickselect on the
+    // existing partition, switching to median of medians pivots after 2 * log2(n) bad splits. O(n) on average.
+    void intro_select(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, std::ptrdiff_t k, PivotStrategy pivot_strategy);
+
+    // Function to sort only the k smallest values of arr[low..high] into arr[low..low+k-1], the rest is left in
+    // unspecified order. intro_select followed by sorting the front, O(n + k log k).
+    void partial_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, std::ptrdiff_t k);
+
+    // Keeps the k smallest values of a stream that doesn't fit in one buffer in a bounded max-heap.
+    // A value that can't make the cut costs one comparison, the others O(log k). Memory is O(k).
+    class StreamingTopK {
+    public:
+        explicit StreamingTopK(std::size_t k);
+
+        void push(int value);
+        void push(const int* values, std::size_t count);
+
+        // The k smallest values pushed so far (all of them if fewer than k), sorted ascending
+        std::vector<int> sorted() const;
+
+    private:
+        std::size_t m_K;
+        std::vector<int> m_Heap;
+    };
+
+    // Function to perform pattern-defeating quick sort (pdqsort): unstable, O(n log n) worst case and O(n) on
+    // sorted, reversed-then-partitioned and all-equal input thanks to partition pattern detection.
+    void pdq_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high);
+
+    // Function to perform quick sort on a work-stealing thread pool.
+    // Sub-partitions are sorted as parallel tasks and huge ranges are partitioned in place by all threads,
+    // num_threads = 0 uses every hardware thread.
+    void parallel_quick_sort(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high, PivotStrategy pivot_strategy, unsigned int num_threads = 0);
+
+    // Function to perform parallel sample sort: splitters are picked from an oversampled random sample, every
+    // thread classifies its block into buckets with a branch-free splitter tree and a per-thread histogram, one
+    // scatter pass moves every element to its bucket and the buckets are sorted in parallel. Duplicate splitters
+    // turn on equality buckets for the keys equal to a splitter, which are filled in place instead of sorted.
+    // num_threads = 0 uses every hardware thread.
+    void parallel_sample_sort(std::vector<int>& data, unsigned int num_threads = 0);
+
+    // Function to sort many independent segments of one flat buffer: segment i is data[offsets[i]..offsets[i+1]-1],
+    // so offsets holds num_segments + 1 ascending entries. Short segments use insertion sort, segments up to
+    // SORTING_NETWORK_MAX the sorting network kernel and longer ones a merge sort through a scratch buffer that is
+    // allocated once per task, never per segment. Consecutive segments are batched into tasks on the thread pool,
+    // num_threads = 0 uses every hardware thread.
+    void segmented_sort(int* data, const std::ptrdiff_t* offsets, std::size_t num_segments, unsigned int num_threads = 0);
+    void segmented_sort(std::vector<int>& data, const std::vector<std::ptrdiff_t>& offsets, unsigned int num_threads = 0);
+
+    // Function to perform LSD radix sort on a vector of integers: 8-bit digits, one histogram pass for all
+    // digits, passes where every key shares the digit are skipped. O(n) time, O(n) extra memory.
+    void radix_sort(std::vector<int>& data);
+
+    // Function to perform in-place MSD radix sort (American flag sort) on a vector of integers.
+    // Buckets are permuted in place and small buckets finished with insertion sort, so the only extra
+    // memory is a few histograms on the stack.
+    void american_flag_sort(std::vector<int>& data);
 
     // Function to perform quick sort with middle pivot on a vector of integers
-    void quick_sort_middle(std::vector<int>& arr, int low, int high);
+    void quick_sort_middle(std::vector<int>& arr, std::ptrdiff_t low, std::ptrdiff_t high);
 }
 
 #endif // SORTING_H
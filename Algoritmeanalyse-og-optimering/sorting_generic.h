@@ -0,0 +1,493 @@
+#pragma once
+
+#ifndef SORTING_GENERIC_H
+#define SORTING_GENERIC_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "sorting_simd.h"
+
+// Header-only sorting over random-access iterators with a comparator and a projection, e.g.
+//
+// sorting::sort(ids.begin(), ids.end());                                          // 64-bit ids, radix sorted
+// sorting::sort(values, values + n, std::greater<double>());                      // Any buffer, any order
+// sorting::stable_sort(rows.begin(), rows.end(), std::less<>(), [](const Row& r) { return r.key; });
+// sorting::sort_by_key(keys, payloads);                                           // Two columns, same permutation
+// std::vector<std::uint32_t> order = sorting::argsort(keys);                      // Or the permutation itself
+//
+// The comparator is applied to the projected keys. When the key is a primitive integer compared with
+// std::less the range is radix sorted, and contiguous int ranges use the SIMD sorting network kernel
+// for small subranges. Both choices are made at compile time.
+
+namespace sorting {
+
+    // Projection that returns the element itself
+    struct identity {
+        template <class T>
+        T&& operator()(T&& value) const { return std::forward<T>(value); }
+    };
+
+    namespace detail {
+        const std::ptrdiff_t GENERIC_INSERTION_SORT_THRESHOLD = 16;     // Ranges this small are insertion sorted
+        const std::ptrdiff_t GENERIC_NETWORK_SORT_THRESHOLD = 32;       // Same for the int fast path, in registers
+        const std::ptrdiff_t GENERIC_RADIX_SORT_THRESHOLD = 256;        // Below this the histograms cost more than they save
+        const int GENERIC_RADIX_BITS = 8;
+        const int GENERIC_RADIX_BUCKETS = 1 << GENERIC_RADIX_BITS;
+
+        // Compares two elements by their projected keys
+        template <class Compare, class Projection>
+        struct projected_less {
+            Compare comp;
+            Projection proj;
+
+            template <class A, class B>
+            bool operator()(const A& a, const B& b) const { return comp(proj(a), proj(b)); }
+        };
+
+        template <class RandomIt, class Projection>
+        struct projected_key {
+            typedef typename std::decay<decltype(std::declval<Projection&>()(*std::declval<RandomIt&>()))>::type type;
+        };
+
+        // True when the keys can be radix sorted: a primitive integer (not bool) compared with std::less,
+        // and elements the scatter buffer can hold
+        template <class RandomIt, class Compare, class Projection>
+        struct use_radix_sort {
+            typedef typename projected_key<RandomIt, Projection>::type Key;
+            typedef typename std::iterator_traits<RandomIt>::value_type Value;
+            static const bool value = std::is_integral<Key>::value && !std::is_same<Key, bool>::value
+                && (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<Key>>::value)
+                && std::is_default_constructible<Value>::value && std::is_move_assignable<Value>::value;
+        };
+
+        // True for contiguous int ranges in ascending order, those can go to network_sort
+        template <class RandomIt, class Compare, class Projection>
+        struct use_network_sort {
+            static const bool value = (std::is_same<RandomIt, int*>::value || std::is_same<RandomIt, std::vector<int>::iterator>::value)
+                && (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<int>>::value)
+                && std::is_same<Projection, identity>::value;
+        };
+
+        // Maps an integer key to an unsigned key with the same order (flipping the sign bit puts negatives first)
+        template <class Key>
+        typename std::make_unsigned<Key>::type radix_key(Key key) {
+            typedef typename std::make_unsigned<Key>::type Unsigned;
+            Unsigned bits = static_cast<Unsigned>(key);
+            if (std::is_signed<Key>::value)
+                bits ^= static_cast<Unsigned>(Unsigned(1) << (sizeof(Key) * 8 - 1));
+            return bits;
+        }
+
+        template <class Key>
+        int radix_digit(Key key, int shift) {
+            return static_cast<int>((detail::radix_key(key) >> shift) & (GENERIC_RADIX_BUCKETS - 1));
+        }
+
+        // Stable scatter of n elements from src to dst by the digit at shift, bucket holds the starting offsets
+        template <class SrcIt, class DstIt, class Projection>
+        void radix_scatter(SrcIt src, std::ptrdiff_t n, DstIt dst, std::size_t* bucket, int shift, Projection& proj) {
+            for (std::ptrdiff_t i = 0; i < n; ++i) {                    // O(n)
+                std::size_t& slot = bucket[detail::radix_digit(proj(src[i]), shift)];
+                dst[slot++] = std::move(src[i]);
+            }
+        }
+
+        // Insertion Sort implementation, stable
+        template <class RandomIt, class Less>
+        void insertion_sort(RandomIt first, RandomIt last, Less& less) {
+            if (first == last) return;
+            for (RandomIt i = first + 1; i != last; ++i) {              // O(k^2) for small k
+                typename std::iterator_traits<RandomIt>::value_type key = std::move(*i);
+                RandomIt j = i;
+                while (j != first && less(key, *(j - 1))) {
+                    *j = std::move(*(j - 1));
+                    --j;
+                }
+                *j = std::move(key);
+            }
+        }
+
+        // Small range base case: insertion sort, or the sorting network kernel for contiguous ints
+        template <class RandomIt, class Less>
+        void small_sort(RandomIt first, RandomIt last, Less& less, std::false_type) {
+            detail::insertion_sort(first, last, less);
+        }
+
+        template <class RandomIt, class Less>
+        void small_sort(RandomIt first, RandomIt last, Less&, std::true_type) {
+            if (last - first > 1)
+                network_sort(&*first, static_cast<int>(last - first));
+        }
+
+        // Sorts *a <= *b <= *c
+        template <class RandomIt, class Less>
+        void sort3(RandomIt a, RandomIt b, RandomIt c, Less& less) {
+            if (less(*b, *a)) std::iter_swap(a, b);
+            if (less(*c, *b)) std::iter_swap(b, c);
+            if (less(*b, *a)) std::iter_swap(a, b);
+        }
+
+        // Hoare partition around the median of the first, middle and last element, returns the pivot position.
+        // Equal keys stop both scans, so duplicates split evenly instead of degrading to O(n^2).
+        template <class RandomIt, class Less>
+        RandomIt hoare_partition(RandomIt first, RandomIt last, Less& less) {
+            // Step 1: Median of three to the front, the last element (>= pivot) then stops the left scan
+            RandomIt mid = first + (last - first) / 2;
+            detail::sort3(first, mid, last - 1, less);
+            std::iter_swap(first, mid);
+
+            // Step 2: Swap misplaced pairs from both ends
+            RandomIt i = first, j = last;
+            while (true) {                                              // O(n)
+                do ++i; while (less(*i, *first));
+                do --j; while (less(*first, *j));
+                if (!(i < j)) break;
+                std::iter_swap(i, j);
+            }
+
+            // Step 3: Swap pivot into its correct position
+            std::iter_swap(first, j);
+            return j;
+        }
+
+        // Intro sort: quick sort with a heap sort fallback once the recursion goes deeper than depth_limit
+        template <class RandomIt, class Less, class NetworkSort>
+        void intro_sort(RandomIt first, RandomIt last, Less& less, int depth_limit, NetworkSort tag) {
+            const std::ptrdiff_t threshold = NetworkSort::value ? GENERIC_NETWORK_SORT_THRESHOLD : GENERIC_INSERTION_SORT_THRESHOLD;
+            while (last - first > threshold) {
+                if (depth_limit-- == 0) {
+                    std::make_heap(first, last, less);                  // O(n)
+                    std::sort_heap(first, last, less);                  // O(n log n) - guaranteed
+                    return;
+                }
+
+                // Recurse into the smaller part, loop on the larger part to keep the stack O(log n)
+                RandomIt pivot = detail::hoare_partition(first, last, less);  // O(n)
+                if (pivot - first < last - pivot) {
+                    detail::intro_sort(first, pivot, less, depth_limit, tag);
+                    first = pivot + 1;
+                }
+                else {
+                    detail::intro_sort(pivot + 1, last, less, depth_limit, tag);
+                    last = pivot;
+                }
+            }
+            detail::small_sort(first, last, less, tag);
+        }
+
+        // Merge sort: sorts both halves in place, moves the left half out to buffer and merges it back.
+        // Ties take from the left half, so the sort is stable.
+        template <class RandomIt, class BufferIt, class Less, class NetworkSort>
+        void merge_sort(RandomIt first, RandomIt last, BufferIt buffer, Less& less, NetworkSort tag) {
+            if (last - first <= (NetworkSort::value ? GENERIC_NETWORK_SORT_THRESHOLD : GENERIC_INSERTION_SORT_THRESHOLD)) {
+                detail::small_sort(first, last, less, tag);
+                return;
+            }
+
+            RandomIt mid = first + (last - first) / 2;
+            detail::merge_sort(first, mid, buffer, less, tag);          // O(log n)
+            detail::merge_sort(mid, last, buffer, less, tag);           // O(log n)
+            if (!less(*mid, *(mid - 1))) return;                        // O(1) - halves are already in order
+
+            BufferIt left = buffer;
+            BufferIt left_end = std::move(first, mid, buffer);          // O(n/2)
+            RandomIt right = mid, out = first;
+            while (left != left_end && right != last)                   // O(n) - out never overtakes right
+                *out++ = less(*right, *left) ? std::move(*right++) : std::move(*left++);
+            std::move(left, left_end, out);                             // Whatever is left of the right half is in place
+        }
+    }
+
+    // Function to perform LSD radix sort on [first, last) by the integer key proj(element), any width up to
+    // 64 bits. 8-bit digits, one histogram pass for all digits, passes where every key shares the digit are
+    // skipped. Stable, O(n) time, O(n) extra memory.
+    template <class RandomIt, class Projection = identity>
+    void radix_sort(RandomIt first, RandomIt last, Projection proj = Projection()) {
+        typedef typename detail::projected_key<RandomIt, Projection>::type Key;
+        typedef typename std::iterator_traits<RandomIt>::value_type Value;
+        static_assert(std::is_integral<Key>::value, "radix_sort needs an integer key");
+        const int passes = static_cast<int>(sizeof(Key));
+        const int buckets = detail::GENERIC_RADIX_BUCKETS;
+
+        const std::ptrdiff_t n = last - first;
+        if (n < 2) return;                                              // O(1)
+
+        // Step 1: One pass over the data builds the histograms for every digit at once
+        std::vector<std::size_t> counts(passes * buckets, 0);
+        for (RandomIt it = first; it != last; ++it) {                   // O(n)
+            Key key = proj(*it);
+            for (int pass = 0; pass < passes; ++pass)                   // O(1)
+                ++counts[pass * buckets + detail::radix_digit(key, pass * detail::GENERIC_RADIX_BITS)];
+        }
+
+        std::vector<Value> buffer(n);                                   // O(n) - LSD radix needs a second array
+        bool in_buffer = false;
+
+        for (int pass = 0; pass < passes; ++pass) {                     // O(passes)
+            const int shift = pass * detail::GENERIC_RADIX_BITS;
+            std::size_t* bucket = &counts[pass * buckets];
+
+            // Step 2: Skip trivial passes where every key has the same digit (e.g. the high bytes of small values)
+            Key head = in_buffer ? proj(buffer[0]) : proj(*first);
+            if (bucket[detail::radix_digit(head, shift)] == static_cast<std::size_t>(n))
+                continue;
+
+            // Step 3: Turn the counts into starting offsets (exclusive prefix sum)
+            std::size_t offset = 0;
+            for (int b = 0; b < buckets; ++b) {                         // O(buckets)
+                std::size_t count = bucket[b];
+                bucket[b] = offset;
+                offset += count;
+            }
+
+            // Step 4: Stable scatter by the current digit
+            if (in_buffer)
+                detail::radix_scatter(buffer.begin(), n, first, bucket, shift, proj);
+            else
+                detail::radix_scatter(first, n, buffer.begin(), bucket, shift, proj);
+            in_buffer = !in_buffer;
+        }
+
+        // Step 5: After an odd number of real passes the result lives in the buffer
+        if (in_buffer)
+            std::move(buffer.begin(), buffer.end(), first);             // O(n)
+    }
+
+    namespace detail {
+        template <class RandomIt, class Less>
+        void sort_dispatch(RandomIt first, RandomIt last, Less& less, std::false_type) {
+            int depth_limit = 0;
+            for (std::ptrdiff_t n = last - first; n > 1; n >>= 1)       // O(log n)
+                depth_limit += 2;
+            detail::intro_sort(first, last, less, depth_limit,
+                std::integral_constant<bool, use_network_sort<RandomIt, decltype(less.comp), decltype(less.proj)>::value>());
+        }
+
+        template <class RandomIt, class Less>
+        void stable_sort_dispatch(RandomIt first, RandomIt last, Less& less, std::false_type) {
+            typedef typename std::iterator_traits<RandomIt>::value_type Value;
+            std::vector<Value> buffer((last - first) / 2);              // O(n/2) - holds the left half of a merge
+            detail::merge_sort(first, last, buffer.begin(), less,
+                std::integral_constant<bool, use_network_sort<RandomIt, decltype(less.comp), decltype(less.proj)>::value>());
+        }
+
+        // Integer keys: radix sort is stable, so both entry points share it for large ranges
+        template <class RandomIt, class Less>
+        void sort_dispatch(RandomIt first, RandomIt last, Less& less, std::true_type) {
+            if (last - first < GENERIC_RADIX_SORT_THRESHOLD)
+                detail::sort_dispatch(first, last, less, std::false_type());
+            else
+                sorting::radix_sort(first, last, less.proj);
+        }
+
+        template <class RandomIt, class Less>
+        void stable_sort_dispatch(RandomIt first, RandomIt last, Less& less, std::true_type) {
+            if (last - first < GENERIC_RADIX_SORT_THRESHOLD)
+                detail::stable_sort_dispatch(first, last, less, std::false_type());
+            else
+                sorting::radix_sort(first, last, less.proj);
+        }
+    }
+
+    // Function to sort [first, last) so that comp(proj(a), proj(b)) holds for earlier a. Not stable.
+    // Integer keys with std::less are radix sorted, everything else is intro sorted (O(n log n) worst case).
+    template <class RandomIt, class Compare = std::less<>, class Projection = identity>
+    void sort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection()) {
+        detail::projected_less<Compare, Projection> less = { comp, proj };
+        detail::sort_dispatch(first, last, less,
+            std::integral_constant<bool, detail::use_radix_sort<RandomIt, Compare, Projection>::value>());
+    }
+
+    // Function to sort [first, last) like sort, keeping equal keys in their original order.
+    // Integer keys with std::less are radix sorted, everything else is merge sorted with an n/2 buffer.
+    template <class RandomIt, class Compare = std::less<>, class Projection = identity>
+    void stable_sort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection()) {
+        detail::projected_less<Compare, Projection> less = { comp, proj };
+        detail::stable_sort_dispatch(first, last, less,
+            std::integral_constant<bool, detail::use_radix_sort<RandomIt, Compare, Projection>::value>());
+    }
+}
+
+namespace sorting {
+
+    // Algorithm behind the key-value sorts, both are stable
+    enum class KeyValueBackend {
+        RADIX,              // LSD radix sort on the key, O(n) but needs integer keys (others fall back to MERGE)
+        MERGE               // Merge sort on the key, O(n log n) with any key that has operator<
+    };
+
+    namespace detail {
+        // LSD radix sort of keys[0..n) that moves values[i] along with keys[i], same passes as radix_sort
+        template <class Key, class Value>
+        void radix_sort_pairs(Key* keys, Value* values, std::ptrdiff_t n) {
+            const int passes = static_cast<int>(sizeof(Key));
+            const int buckets = GENERIC_RADIX_BUCKETS;
+            if (n < 2) return;                                          // O(1)
+
+            // Step 1: One pass over the keys builds the histograms for every digit at once
+            std::vector<std::size_t> counts(passes * buckets, 0);
+            for (std::ptrdiff_t i = 0; i < n; ++i) {                    // O(n)
+                for (int pass = 0; pass < passes; ++pass)               // O(1)
+                    ++counts[pass * buckets + detail::radix_digit(keys[i], pass * GENERIC_RADIX_BITS)];
+            }
+
+            std::vector<Key> key_buffer(n);                             // O(n) - both columns need a second array
+            std::vector<Value> value_buffer(n);
+            Key* key_src = keys;
+            Key* key_dst = key_buffer.data();
+            Value* value_src = values;
+            Value* value_dst = value_buffer.data();
+
+            for (int pass = 0; pass < passes; ++pass) {                 // O(passes)
+                const int shift = pass * GENERIC_RADIX_BITS;
+                std::size_t* bucket = &counts[pass * buckets];
+
+                // Step 2: Skip trivial passes where every key has the same digit
+                if (bucket[detail::radix_digit(key_src[0], shift)] == static_cast<std::size_t>(n))
+                    continue;
+
+                // Step 3: Turn the counts into starting offsets (exclusive prefix sum)
+                std::size_t offset = 0;
+                for (int b = 0; b < buckets; ++b) {                     // O(buckets)
+                    std::size_t count = bucket[b];
+                    bucket[b] = offset;
+                    offset += count;
+                }
+
+                // Step 4: Stable scatter of both columns by the key digit
+                for (std::ptrdiff_t i = 0; i < n; ++i) {                // O(n)
+                    std::size_t slot = bucket[detail::radix_digit(key_src[i], shift)]++;
+                    key_dst[slot] = key_src[i];
+                    value_dst[slot] = std::move(value_src[i]);
+                }
+                std::swap(key_src, key_dst);
+                std::swap(value_src, value_dst);
+            }
+
+            // Step 5: After an odd number of real passes the result lives in the buffers
+            if (key_src != keys) {
+                std::copy(key_src, key_src + n, keys);                  // O(n)
+                std::move(value_src, value_src + n, values);            // O(n)
+            }
+        }
+
+        // Merge sort of keys[0..n) that moves values[i] along with keys[i], same scheme as merge_sort above:
+        // the left halves of both columns go to the buffers and are merged back, ties take from the left
+        template <class Key, class Value>
+        void merge_sort_pairs(Key* keys, Value* values, std::ptrdiff_t n, Key* key_buffer, Value* value_buffer) {
+            if (n <= GENERIC_INSERTION_SORT_THRESHOLD) {
+                for (std::ptrdiff_t i = 1; i < n; ++i) {                // O(k^2) for small k
+                    Key key = std::move(keys[i]);
+                    Value value = std::move(values[i]);
+                    std::ptrdiff_t j = i;
+                    while (j > 0 && key < keys[j - 1]) {
+                        keys[j] = std::move(keys[j - 1]);
+                        values[j] = std::move(values[j - 1]);
+                        --j;
+                    }
+                    keys[j] = std::move(key);
+                    values[j] = std::move(value);
+                }
+                return;
+            }
+
+            const std::ptrdiff_t mid = n / 2;
+            detail::merge_sort_pairs(keys, values, mid, key_buffer, value_buffer);                  // O(log n)
+            detail::merge_sort_pairs(keys + mid, values + mid, n - mid, key_buffer, value_buffer);  // O(log n)
+            if (!(keys[mid] < keys[mid - 1])) return;                   // O(1) - halves are already in order
+
+            std::move(keys, keys + mid, key_buffer);                    // O(n/2)
+            std::move(values, values + mid, value_buffer);              // O(n/2)
+            std::ptrdiff_t left = 0, right = mid, out = 0;
+            while (left < mid && right < n) {                           // O(n) - out never overtakes right
+                if (keys[right] < key_buffer[left]) {
+                    keys[out] = std::move(keys[right]);
+                    values[out++] = std::move(values[right++]);
+                }
+                else {
+                    keys[out] = std::move(key_buffer[left]);
+                    values[out++] = std::move(value_buffer[left++]);
+                }
+            }
+            std::move(key_buffer + left, key_buffer + mid, keys + out);     // Whatever is left of the right half is in place
+            std::move(value_buffer + left, value_buffer + mid, values + out);
+        }
+
+        template <class Key, class Value>
+        void sort_pairs(Key* keys, Value* values, std::ptrdiff_t n, KeyValueBackend, std::false_type) {
+            std::vector<Key> key_buffer(n / 2);                         // O(n/2) - holds the left half of a merge
+            std::vector<Value> value_buffer(n / 2);
+            detail::merge_sort_pairs(keys, values, n, key_buffer.data(), value_buffer.data());
+        }
+
+        // Integer keys: radix sort unless the merge backend was asked for or the range is small
+        template <class Key, class Value>
+        void sort_pairs(Key* keys, Value* values, std::ptrdiff_t n, KeyValueBackend backend, std::true_type) {
+            if (backend == KeyValueBackend::RADIX && n >= GENERIC_RADIX_SORT_THRESHOLD)
+                detail::radix_sort_pairs(keys, values, n);
+            else
+                detail::sort_pairs(keys, values, n, backend, std::false_type());
+        }
+    }
+
+    // Function to sort keys[0..n) ascending (struct-of-arrays layout) and apply the same permutation to
+    // values[0..n), e.g. to sort one column of a table and carry another along. Stable.
+    template <class Key, class Value>
+    void sort_by_key(Key* keys, Value* values, std::size_t n, KeyValueBackend backend = KeyValueBackend::RADIX) {
+        detail::sort_pairs(keys, values, static_cast<std::ptrdiff_t>(n), backend,
+            std::integral_constant<bool, std::is_integral<Key>::value && !std::is_same<Key, bool>::value>());
+    }
+
+    // Same for two vectors, values must be at least as long as keys
+    template <class Key, class Value>
+    void sort_by_key(std::vector<Key>& keys, std::vector<Value>& values, KeyValueBackend backend = KeyValueBackend::RADIX) {
+        sorting::sort_by_key(keys.data(), values.data(), keys.size(), backend);
+    }
+
+    // Function to sort records [first, last) (array-of-structs layout) ascending by the key proj(record).
+    // The whole record moves with its key. Stable.
+    template <class RandomIt, class Projection>
+    void sort_records_by_key(RandomIt first, RandomIt last, Projection proj, KeyValueBackend backend = KeyValueBackend::RADIX) {
+        typedef typename detail::projected_key<RandomIt, Projection>::type Key;
+        if (backend == KeyValueBackend::RADIX && std::is_integral<Key>::value) {
+            sorting::stable_sort(first, last, std::less<>(), proj);    // Integer keys with std::less are radix sorted
+            return;
+        }
+
+        // A comparator other than std::less keeps stable_sort off the radix path
+        typedef typename std::iterator_traits<RandomIt>::value_type Value;
+        std::vector<Value> buffer((last - first) / 2);                  // O(n/2) - holds the left half of a merge
+        detail::projected_less<std::less<Key>, Projection> less = { std::less<Key>(), proj };
+        detail::merge_sort(first, last, buffer.begin(), less, std::false_type());
+    }
+
+    // Function to return the permutation that sorts keys (argsort): keys[order[0]] <= keys[order[1]] <= ...
+    // Equal keys keep their original order. Index must be able to hold keys.size() - 1.
+    template <class Index = std::uint32_t, class Key>
+    std::vector<Index> argsort(const std::vector<Key>& keys, KeyValueBackend backend = KeyValueBackend::RADIX) {
+        std::vector<Key> sorted_keys(keys);                             // O(n) - the keys are sorted along with the indices
+        std::vector<Index> order(keys.size());
+        std::iota(order.begin(), order.end(), Index(0));                // O(n)
+        sorting::sort_by_key(sorted_keys, order, backend);
+        return order;
+    }
+
+    // Function to apply a permutation from argsort to a column: result[i] = column[order[i]]
+    template <class T, class Index>
+    std::vector<T> gather(const std::vector<T>& column, const std::vector<Index>& order) {
+        std::vector<T> result;
+        result.reserve(order.size());
+        for (Index index : order)                                       // O(n) - random reads, sequential writes
+            result.push_back(column[index]);
+        return result;
+    }
+}
+
+#endif // SORTING_GENERIC_H
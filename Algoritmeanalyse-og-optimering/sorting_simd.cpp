@@ -0,0 +1,272 @@
+#include "sorting_simd.h"
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#if defined(__AVX2__)
+#define SORTING_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE4_1__) || defined(__AVX__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+// MSVC never defines __SSE4_1__, but its x64 compiler always accepts SSE4.1 intrinsics, so without /arch:AVX2
+// x64 builds take the SSE4.1 path (every x64 CPU since 2008 has it)
+#define SORTING_SIMD_SSE41
+#include <smmintrin.h>
+#endif
+
+namespace sorting {
+
+    void scalar_merge(const int* a, std::ptrdiff_t n1, const int* b, std::ptrdiff_t n2, int* out) {
+        const int* a_end = a + n1;
+        const int* b_end = b + n2;
+        while (a != a_end && b != b_end)
+            *out++ = (*b < *a) ? *b++ : *a++;
+        out = std::copy(a, a_end, out);
+        std::copy(b, b_end, out);
+    }
+
+#if defined(SORTING_SIMD_AVX2)
+    // AVX2 register operations, 8 ints per register
+    struct SimdOps {
+        typedef __m256i Reg;
+        static const int WIDTH = 8;
+
+        static Reg load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static void store(int* p, Reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        static Reg min(Reg a, Reg b) { return _mm256_min_epi32(a, b); }
+        static Reg max(Reg a, Reg b) { return _mm256_max_epi32(a, b); }
+        static Reg reverse(Reg v) { return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+
+        // One compare-exchange step between element i and element i ^ distance, MASK marks the lanes that keep the max
+        template <int MASK> static Reg step_1(Reg v) {
+            Reg p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+            return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), MASK);
+        }
+        template <int MASK> static Reg step_2(Reg v) {
+            Reg p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+            return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), MASK);
+        }
+        template <int MASK> static Reg step_4(Reg v) {
+            Reg p = _mm256_permute2x128_si256(v, v, 1);
+            return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), MASK);
+        }
+
+        // Full bitonic sort of the 8 lanes
+        static Reg sort_register(Reg v) {
+            v = step_1<0x66>(v);    // Pairs, alternating direction
+            v = step_2<0x3C>(v);    // Quads, alternating direction
+            v = step_1<0x5A>(v);
+            return clean_register(v);
+        }
+
+        // Sorts a bitonic register
+        static Reg clean_register(Reg v) {
+            v = step_4<0xF0>(v);
+            v = step_2<0xCC>(v);
+            return step_1<0xAA>(v);
+        }
+    };
+#elif defined(SORTING_SIMD_SSE41)
+    // SSE4.1 register operations, 4 ints per register
+    struct SimdOps {
+        typedef __m128i Reg;
+        static const int WIDTH = 4;
+
+        static Reg load(const int* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static void store(int* p, Reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static Reg min(Reg a, Reg b) { return _mm_min_epi32(a, b); }
+        static Reg max(Reg a, Reg b) { return _mm_max_epi32(a, b); }
+        static Reg reverse(Reg v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+
+        template <int MASK> static Reg blend(Reg a, Reg b) {
+            return _mm_castps_si128(_mm_blend_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), MASK));
+        }
+        template <int MASK> static Reg step_1(Reg v) {
+            Reg p = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+            return blend<MASK>(_mm_min_epi32(v, p), _mm_max_epi32(v, p));
+        }
+        template <int MASK> static Reg step_2(Reg v) {
+            Reg p = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+            return blend<MASK>(_mm_min_epi32(v, p), _mm_max_epi32(v, p));
+        }
+
+        static Reg sort_register(Reg v) {
+            v = step_1<0x6>(v);     // Pairs, alternating direction
+            return clean_register(v);
+        }
+
+        static Reg clean_register(Reg v) {
+            v = step_2<0xC>(v);
+            return step_1<0xA>(v);
+        }
+    };
+#endif
+
+#if defined(SORTING_SIMD_AVX2) || defined(SORTING_SIMD_SSE41)
+    typedef SimdOps::Reg Reg;
+
+    // Sorts a bitonic sequence spread over count registers (each register itself ends up sorted)
+    template <int COUNT>
+    void bitonic_clean_registers(Reg* r) {
+        for (int distance = COUNT / 2; distance >= 1; distance /= 2) {
+            for (int i = 0; i < COUNT; ++i) {
+                if ((i & distance) == 0) {
+                    Reg low = SimdOps::min(r[i], r[i + distance]);
+                    r[i + distance] = SimdOps::max(r[i], r[i + distance]);
+                    r[i] = low;
+                }
+            }
+        }
+        for (int i = 0; i < COUNT; ++i)
+            r[i] = SimdOps::clean_register(r[i]);
+    }
+
+    // Merges two sorted runs of RUN registers each, r[0..RUN) and r[RUN..2*RUN)
+    template <int RUN>
+    void merge_registers(Reg* r) {
+        // Reversing the second run makes the pair one bitonic sequence
+        for (int i = 0; i < RUN / 2; ++i)
+            std::swap(r[RUN + i], r[2 * RUN - 1 - i]);
+        for (int i = 0; i < RUN; ++i)
+            r[RUN + i] = SimdOps::reverse(r[RUN + i]);
+
+        // One half-cleaner splits it into a low and a high bitonic half
+        for (int i = 0; i < RUN; ++i) {
+            Reg low = SimdOps::min(r[i], r[RUN + i]);
+            r[RUN + i] = SimdOps::max(r[i], r[RUN + i]);
+            r[i] = low;
+        }
+        bitonic_clean_registers<RUN>(r);
+        bitonic_clean_registers<RUN>(r + RUN);
+    }
+
+    // Sorts COUNT registers as one sequence: both halves recursively, then one register merge
+    template <int COUNT>
+    void sort_registers(Reg* r) {
+        sort_registers<COUNT / 2>(r);
+        sort_registers<COUNT / 2>(r + COUNT / 2);
+        merge_registers<COUNT / 2>(r);
+    }
+
+    template <>
+    void sort_registers<1>(Reg* r) {
+        r[0] = SimdOps::sort_register(r[0]);
+    }
+
+    template <int COUNT>
+    void network_sort_block(int* data, int n) {
+        // Pad to a whole block with INT_MAX, the padding sorts to the end and is dropped again
+        int block[COUNT * SimdOps::WIDTH];
+        std::copy(data, data + n, block);
+        std::fill(block + n, block + COUNT * SimdOps::WIDTH, INT_MAX);
+
+        Reg r[COUNT];
+        for (int i = 0; i < COUNT; ++i)
+            r[i] = SimdOps::load(block + i * SimdOps::WIDTH);
+        sort_registers<COUNT>(r);
+        for (int i = 0; i < COUNT; ++i)
+            SimdOps::store(block + i * SimdOps::WIDTH, r[i]);
+
+        std::copy(block, block + n, data);
+    }
+
+    void network_sort(int* data, int n) {
+        const int W = SimdOps::WIDTH;
+        if (n < 2) return;
+
+        // Smallest power-of-two number of registers that holds the range
+        if (n <= W)                     network_sort_block<1>(data, n);
+        else if (n <= 2 * W)            network_sort_block<2>(data, n);
+        else if (n <= 4 * W)            network_sort_block<4>(data, n);
+        else if (n <= 8 * W)            network_sort_block<8>(data, n);
+        else if (n <= SORTING_NETWORK_MAX) network_sort_block<SORTING_NETWORK_MAX / W>(data, n);
+        else {
+            // Longer than one network: sort every SORTING_NETWORK_MAX block, then merge the blocks bottom-up through a buffer
+            for (int lo = 0; lo < n; lo += SORTING_NETWORK_MAX)
+                network_sort_block<SORTING_NETWORK_MAX / W>(data + lo, std::min(SORTING_NETWORK_MAX, n - lo));
+            std::vector<int> buffer(n);
+            for (int width = SORTING_NETWORK_MAX; width < n; width *= 2) {          // O(log(n / 64)) passes
+                for (int lo = 0; lo < n; lo += 2 * width) {
+                    int mid = std::min(lo + width, n);
+                    int hi = std::min(lo + 2 * width, n);
+                    bitonic_merge(data + lo, mid - lo, data + mid, hi - mid, buffer.data() + lo);  // O(n) per pass
+                }
+                std::copy(buffer.begin(), buffer.end(), data);
+            }
+        }
+    }
+
+    // Merges WIDTH elements at a time (Inoue et al. 2007): the register merge of a and b keeps the
+    // WIDTH smallest in lo (written out) and the WIDTH largest in hi, which is merged with the next
+    // block taken from whichever input has the smaller head element.
+    void bitonic_merge(const int* a, std::ptrdiff_t n1, const int* b, std::ptrdiff_t n2, int* out) {
+        const int W = SimdOps::WIDTH;
+        if (n1 < W || n2 < W) {
+            scalar_merge(a, n1, b, n2, out);
+            return;
+        }
+
+        Reg lo = SimdOps::load(a);
+        Reg hi = SimdOps::load(b);
+        std::ptrdiff_t i = W, j = W;
+        while (true) {
+            // Register merge of two sorted registers: reverse one, half-clean, then sort both halves
+            Reg reversed = SimdOps::reverse(hi);
+            Reg low = SimdOps::min(lo, reversed);
+            hi = SimdOps::clean_register(SimdOps::max(lo, reversed));
+            SimdOps::store(out, SimdOps::clean_register(low));
+            out += W;
+
+            // Next block from the input with the smaller head
+            if (i < n1 && (j >= n2 || a[i] <= b[j])) {
+                if (n1 - i < W) break;
+                lo = SimdOps::load(a + i);
+                i += W;
+            }
+            else if (j < n2) {
+                if (n2 - j < W) break;
+                lo = SimdOps::load(b + j);
+                j += W;
+            }
+            else {
+                break;
+            }
+        }
+
+        // Scalar finish: hi holds W pending elements, one input has fewer than W left
+        int pending[2 * SORTING_NETWORK_MAX];
+        SimdOps::store(pending, hi);
+        std::ptrdiff_t pending_size = W;
+        if (n1 - i < W) {
+            scalar_merge(pending, W, a + i, n1 - i, pending + W);
+            std::copy(pending + W, pending + 2 * W + (n1 - i), pending);
+            pending_size += n1 - i;
+            scalar_merge(pending, pending_size, b + j, n2 - j, out);
+        }
+        else {
+            scalar_merge(pending, W, b + j, n2 - j, pending + W);
+            std::copy(pending + W, pending + 2 * W + (n2 - j), pending);
+            pending_size += n2 - j;
+            scalar_merge(pending, pending_size, a + i, n1 - i, out);
+        }
+    }
+#else
+    // No SIMD support (e.g. ARM64 builds), fall back to the scalar merge
+    void bitonic_merge(const int* a, std::ptrdiff_t n1, const int* b, std::ptrdiff_t n2, int* out) {
+        scalar_merge(a, n1, b, n2, out);
+    }
+
+    // No SIMD support (e.g. ARM64 builds), fall back to insertion sort
+    void network_sort(int* data, int n) {
+        for (int i = 1; i < n; ++i) {
+            int key = data[i];
+            int j = i - 1;
+            while (j >= 0 && data[j] > key) {
+                data[j + 1] = data[j];
+                --j;
+            }
+            data[j + 1] = key;
+        }
+    }
+#endif
+
+} // namespace sorting
@@ -0,0 +1,26 @@
+#pragma once
+
+#ifndef SORTING_SIMD_H
+#define SORTING_SIMD_H
+
+#include <cstddef>
+
+namespace sorting {
+    // Largest range the sorting network kernel handles in registers
+    const int SORTING_NETWORK_MAX = 64;
+
+    // Function to sort data[0..n-1] with a bitonic sorting network in SIMD registers. Ranges longer than
+    // SORTING_NETWORK_MAX are sorted in blocks of that size and merged through an n-sized buffer.
+    // Uses AVX2 (8 ints per register) when compiled with /arch:AVX2 or -mavx2, SSE4.1 (4 ints per register)
+    // with -msse4.1 or on any MSVC x64 build, and insertion sort otherwise.
+    void network_sort(int* data, int n);
+
+    // Function to merge the sorted runs a[0..n1-1] and b[0..n2-1] into out with a bitonic merge network,
+    // one SIMD register of elements per step (AVX2/SSE4.1 as above, scalar merge otherwise)
+    void bitonic_merge(const int* a, std::ptrdiff_t n1, const int* b, std::ptrdiff_t n2, int* out);
+
+    // Function to merge the sorted runs a[0..n1-1] and b[0..n2-1] into out one element at a time
+    void scalar_merge(const int* a, std::ptrdiff_t n1, const int* b, std::ptrdiff_t n2, int* out);
+}
+
+#endif // SORTING_SIMD_H